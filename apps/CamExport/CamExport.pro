@@ -0,0 +1,50 @@
+#-------------------------------------------------
+#
+# Headless command line tool to generate fabrication output
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = librepcb-cam-export
+
+# Set the path for the generated binary
+GENERATED_DIR = ../../generated
+
+# Use common project definitions
+include(../../common.pri)
+
+QT += core widgets network xml sql printsupport opengl
+
+unix:!macx {
+    # Linux/UNIX-specific configurations
+    target.path = $${PREFIX}/bin
+    INSTALLS += target
+}
+
+LIBS += \
+    -L$${DESTDIR} \
+    -llibrepcbproject \
+    -llibrepcblibrary \    # Note: The order of the libraries is very important for the linker!
+    -llibrepcbcommon \     # Another order could end up in "undefined reference" errors!
+    -lsexpresso \
+    -lclipper \
+
+INCLUDEPATH += \
+    ../../libs
+
+DEPENDPATH += \
+    ../../libs/librepcb/project \
+    ../../libs/librepcb/library \
+    ../../libs/librepcb/common \
+    ../../libs/sexpresso \
+    ../../libs/clipper \
+
+PRE_TARGETDEPS += \
+    $${DESTDIR}/liblibrepcbproject.a \
+    $${DESTDIR}/liblibrepcblibrary.a \
+    $${DESTDIR}/liblibrepcbcommon.a \
+    $${DESTDIR}/libsexpresso.a \
+    $${DESTDIR}/libclipper.a \
+
+SOURCES += \
+    main.cpp \
@@ -0,0 +1,230 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcb/common/application.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/metadata/projectmetadata.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardgerberexport.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+using namespace librepcb::project;
+
+/*****************************************************************************************
+ *  Exit Codes
+ ****************************************************************************************/
+
+enum ExitCode {
+    ExitSuccess         = 0,    ///< all requested boards exported
+    ExitExportFailed    = 1,    ///< the project could not be opened or an export failed
+    ExitInvalidUsage    = 2,    ///< invalid command line arguments or unknown board name
+};
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static void print(const QString& str) noexcept;
+static void printError(const QString& str) noexcept;
+static FilePath getDefaultOutputDir(const Project& project) noexcept;
+static bool exportBoard(Board& board, const FilePath& outputDir,
+                        bool optimizeDrillRoute) noexcept;
+
+/*****************************************************************************************
+ *  main()
+ ****************************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    // The board items are QGraphicsItems which need a GUI application object, but no
+    // display is required. Use the offscreen platform unless another one is requested.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
+    Application::setOrganizationName("LibrePCB");
+    Application::setOrganizationDomain("librepcb.org");
+    Application::setApplicationName("LibrePCB CAM Export");
+
+    // parse command line arguments
+    QCommandLineParser parser;
+    parser.setApplicationDescription(Application::translate("CamExport",
+        "Generates the Gerber and Excellon files of a LibrePCB project without any "
+        "user interaction."));
+    QCommandLineOption helpOption = parser.addHelpOption();
+    parser.addPositionalArgument("project", Application::translate("CamExport",
+        "Path to the project file (*.lpp)."));
+    QCommandLineOption boardOption(QStringList() << "b" << "board",
+        Application::translate("CamExport", "Name of the board to export. Can be given "
+        "multiple times. If omitted, all boards are exported."),
+        Application::translate("CamExport", "name"));
+    QCommandLineOption outputOption(QStringList() << "o" << "output",
+        Application::translate("CamExport", "Output directory. Defaults to "
+        "\"output/<version>/gerber\" in the project directory. If more than one board "
+        "is exported, each board is written to a subdirectory named like the board."),
+        Application::translate("CamExport", "directory"));
+    QCommandLineOption noDrillOptimizationOption("no-drill-optimization",
+        Application::translate("CamExport", "Write the drills in the order of the board "
+        "items instead of optimizing the travel distance of the drill head."));
+    QCommandLineOption verboseOption(QStringList() << "v" << "verbose",
+        Application::translate("CamExport", "Print debug messages."));
+    parser.addOption(boardOption);
+    parser.addOption(outputOption);
+    parser.addOption(noDrillOptimizationOption);
+    parser.addOption(verboseOption);
+    // don't use QCommandLineParser::process() since it exits the application with its
+    // own exit code on "--help" or invalid arguments
+    if (!parser.parse(app.arguments())) {
+        printError(parser.errorText());
+        return ExitInvalidUsage;
+    }
+    if (parser.isSet(helpOption)) {
+        print(parser.helpText().trimmed());
+        return ExitSuccess;
+    }
+
+    if (parser.positionalArguments().count() != 1) {
+        printError(Application::translate("CamExport", "Exactly one project file must "
+                                          "be specified."));
+        return ExitInvalidUsage;
+    }
+    if (!parser.isSet(verboseOption)) {
+        QLoggingCategory::setFilterRules("*.debug=false");
+    }
+
+    try
+    {
+        // open the project read-only, so it is neither locked nor modified and multiple
+        // processes can export the same project at the same time
+        FilePath projectFp(QFileInfo(parser.positionalArguments().first()).absoluteFilePath());
+        Project project(projectFp, true); // can throw
+
+        // determine the boards to export
+        QList<Board*> boards;
+        if (parser.isSet(boardOption)) {
+            foreach (const QString& name, parser.values(boardOption)) {
+                Board* board = project.getBoardByName(name);
+                if (!board) {
+                    printError(QString(Application::translate("CamExport",
+                        "The project does not contain a board named \"%1\".")).arg(name));
+                    return ExitInvalidUsage;
+                }
+                if (!boards.contains(board)) {
+                    boards.append(board);
+                }
+            }
+        } else {
+            boards = project.getBoards();
+        }
+
+        // export the boards
+        FilePath outputDir = parser.isSet(outputOption)
+            ? FilePath(QFileInfo(parser.value(outputOption)).absoluteFilePath())
+            : getDefaultOutputDir(project);
+        bool success = true;
+        foreach (Board* board, boards) {
+            FilePath boardOutputDir = outputDir;
+            if (boards.count() > 1) {
+                boardOutputDir = outputDir.getPathTo(FilePath::cleanFileName(
+                    board->getName(), FilePath::ReplaceSpaces | FilePath::KeepCase));
+            }
+            success = exportBoard(*board, boardOutputDir,
+                                  !parser.isSet(noDrillOptimizationOption)) && success;
+        }
+        return success ? ExitSuccess : ExitExportFailed;
+    }
+    catch (const Exception& e)
+    {
+        printError(QString(Application::translate("CamExport",
+            "Could not open the project: %1")).arg(e.getMsg()));
+        return ExitExportFailed;
+    }
+}
+
+/*****************************************************************************************
+ *  print() / printError()
+ ****************************************************************************************/
+
+static void print(const QString& str) noexcept
+{
+    QTextStream(stdout) << str << endl;
+}
+
+static void printError(const QString& str) noexcept
+{
+    QTextStream(stderr) << str << endl;
+}
+
+/*****************************************************************************************
+ *  getDefaultOutputDir()
+ ****************************************************************************************/
+
+static FilePath getDefaultOutputDir(const Project& project) noexcept
+{
+    // same directory as used by the fabrication output dialog
+    QString version = FilePath::cleanFileName(project.getMetadata().getVersion(),
+                      FilePath::ReplaceSpaces | FilePath::KeepCase);
+    return project.getPath().getPathTo(QString("output/%1/gerber").arg(version));
+}
+
+/*****************************************************************************************
+ *  exportBoard()
+ ****************************************************************************************/
+
+static bool exportBoard(Board& board, const FilePath& outputDir,
+                        bool optimizeDrillRoute) noexcept
+{
+    print(QString(Application::translate("CamExport", "Export board \"%1\" to \"%2\"..."))
+          .arg(board.getName(), outputDir.toNative()));
+    try
+    {
+        // rebuild planes because they may be outdated!
+        board.rebuildAllPlanes();
+
+        BoardGerberExport grbExport(board, outputDir);
+        grbExport.setDrillRouteOptimization(optimizeDrillRoute);
+        QObject::connect(&grbExport, &BoardGerberExport::layerExported,
+            [](const FilePath& filepath, int exportedLayers, int totalLayers) {
+                print(QString("  [%1/%2] %3").arg(exportedLayers).arg(totalLayers)
+                      .arg(filepath.getFilename()));
+            });
+        grbExport.exportAllLayers(); // can throw
+        print(QString(Application::translate("CamExport", "  Travel distance of the drill "
+              "head: %1 mm")).arg(grbExport.getDrillTravelDistance().toMmString()));
+        return true;
+    }
+    catch (const Exception& e)
+    {
+        printError(QString(Application::translate("CamExport",
+            "Failed to export board \"%1\": %2")).arg(board.getName(), e.getMsg()));
+        return false;
+    }
+}
@@ -2,6 +2,7 @@ TEMPLATE = subdirs
 
 SUBDIRS = \
     librepcb \
+    CamExport \
     EagleImport \
     ProjectLibraryUpdater \
     UuidGenerator \
@@ -20,6 +20,8 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <algorithm>
+#include <limits>
 #include <QtCore>
 #include "excellongenerator.h"
 #include "../fileio/smarttextfile.h"
@@ -35,7 +37,7 @@ namespace librepcb {
  ****************************************************************************************/
 
 ExcellonGenerator::ExcellonGenerator() noexcept :
-    mOutput()
+    mOutput(), mRouteOptimization(false), mTravelDistance(0)
 {
 }
 
@@ -71,6 +73,7 @@ void ExcellonGenerator::reset() noexcept
 {
     mOutput.clear();
     mDrillList.clear();
+    mTravelDistance = Length(0);
 }
 
 /*****************************************************************************************
@@ -98,22 +101,33 @@ void ExcellonGenerator::printHeader() noexcept
 
 void ExcellonGenerator::printToolList() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-        Length dia = mDrillList.uniqueKeys().value(i);
-        mOutput.append(QString("T%1C%2\n").arg(i+1).arg(dia.toMmString()));
+    QList<Length> diameters = mDrillList.uniqueKeys();
+    for (int i = 0; i < diameters.count(); ++i) {
+        mOutput.append(QString("T%1C%2\n").arg(i+1).arg(diameters.at(i).toMmString()));
     }
 }
 
 void ExcellonGenerator::printDrills() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
+    qreal travelDistance = 0;
+    Point position(0, 0); // the drill head starts at the origin
+    QList<Length> diameters = mDrillList.uniqueKeys();
+    for (int i = 0; i < diameters.count(); ++i) {
         mOutput.append(QString("T%1\n").arg(i+1)); // Select Tool
-        Length dia = mDrillList.uniqueKeys().value(i);
-        foreach (const Point& pos, mDrillList.values(dia)) {
+        QVector<Point> hits = mDrillList.values(diameters.at(i)).toVector();
+        if (mRouteOptimization) {
+            // the tool change does not move the drill head, so start at the last position
+            hits = sortByNearestNeighbour(hits, position);
+            improveBy2Opt(hits, position);
+        }
+        foreach (const Point& pos, hits) {
+            travelDistance += distance(position, pos);
+            position = pos;
             mOutput.append(QString("X%1Y%2\n").arg(pos.getX().toMmString(),
                                                    pos.getY().toMmString()));
         }
     }
+    mTravelDistance = Length(qRound64(travelDistance));
 }
 
 void ExcellonGenerator::printFooter() noexcept
@@ -122,6 +136,127 @@ void ExcellonGenerator::printFooter() noexcept
     mOutput.append("M30\n");        // End of Program Rewind
 }
 
+/*****************************************************************************************
+ *  Route Optimization
+ ****************************************************************************************/
+
+QVector<Point> ExcellonGenerator::sortByNearestNeighbour(const QVector<Point>& hits,
+                                                         const Point& start) noexcept
+{
+    if (hits.count() < 2) {
+        return hits;
+    }
+
+    // Put the hits into a grid of (on average) one hit per cell, so the nearest hit can
+    // be found by searching the cells around the current position ring by ring.
+    LengthBase_t left = hits.first().getX().toNm(), right = left;
+    LengthBase_t bottom = hits.first().getY().toNm(), top = bottom;
+    foreach (const Point& hit, hits) {
+        left = qMin(left, hit.getX().toNm());
+        right = qMax(right, hit.getX().toNm());
+        bottom = qMin(bottom, hit.getY().toNm());
+        top = qMax(top, hit.getY().toNm());
+    }
+    qreal width = qMax(qreal(right - left), qreal(1));
+    qreal height = qMax(qreal(top - bottom), qreal(1));
+    qreal cellSize = qSqrt((width * height) / hits.count());
+    int columns = qBound(1, qCeil(width / cellSize), hits.count());
+    int rows = qBound(1, qCeil(height / cellSize), hits.count());
+    qreal cellWidth = width / columns;
+    qreal cellHeight = height / rows;
+    auto column = [&](const Point& p) {
+        return qBound(0, qFloor((p.getX().toNm() - left) / cellWidth), columns - 1);
+    };
+    auto row = [&](const Point& p) {
+        return qBound(0, qFloor((p.getY().toNm() - bottom) / cellHeight), rows - 1);
+    };
+    QVector<QVector<int>> cells(columns * rows); // indices of not yet visited hits
+    for (int i = 0; i < hits.count(); ++i) {
+        cells[row(hits.at(i)) * columns + column(hits.at(i))].append(i);
+    }
+
+    QVector<Point> route;
+    route.reserve(hits.count());
+    Point position = start;
+    while (route.count() < hits.count()) {
+        int centerColumn = column(position);
+        int centerRow = row(position);
+        int bestCell = -1;
+        int bestIndex = -1;
+        qreal bestDistance = 0;
+        for (int ring = 0; ; ++ring) {
+            for (int y = centerRow - ring; y <= centerRow + ring; ++y) {
+                if ((y < 0) || (y >= rows)) continue;
+                bool isEdgeRow = (qAbs(y - centerRow) == ring);
+                for (int x = centerColumn - ring; x <= centerColumn + ring;
+                     x += (isEdgeRow || (ring == 0)) ? 1 : (2 * ring)) {
+                    if ((x < 0) || (x >= columns)) continue;
+                    int cell = y * columns + x;
+                    for (int k = 0; k < cells.at(cell).count(); ++k) {
+                        qreal d = distance(position, hits.at(cells.at(cell).at(k)));
+                        if ((bestIndex < 0) || (d < bestDistance)) {
+                            bestCell = cell;
+                            bestIndex = k;
+                            bestDistance = d;
+                        }
+                    }
+                }
+            }
+            // determine the minimum distance to the cells outside of the searched rings
+            bool columnsLeft = (centerColumn - ring > 0) || (centerColumn + ring < columns - 1);
+            bool rowsLeft = (centerRow - ring > 0) || (centerRow + ring < rows - 1);
+            if ((!columnsLeft) && (!rowsLeft)) break; // the whole grid is searched
+            qreal minDistance = std::numeric_limits<qreal>::max();
+            if (columnsLeft) minDistance = qMin(minDistance, ring * cellWidth);
+            if (rowsLeft) minDistance = qMin(minDistance, ring * cellHeight);
+            if ((bestIndex >= 0) && (bestDistance <= minDistance)) break;
+        }
+        Q_ASSERT((bestCell >= 0) && (bestIndex >= 0));
+        QVector<int>& cell = cells[bestCell];
+        position = hits.at(cell.at(bestIndex));
+        route.append(position);
+        cell[bestIndex] = cell.last();
+        cell.removeLast();
+    }
+    return route;
+}
+
+void ExcellonGenerator::improveBy2Opt(QVector<Point>& route, const Point& start) noexcept
+{
+    // Only reverse segments of limited length to keep the runtime linear for boards with
+    // a huge number of holes. The nearest neighbour tour is mostly bad locally anyway.
+    const int maxSegmentLength = 100;
+    const int maxPasses = 10;
+
+    // the route is open (the drill head does not return), and its start point is fixed
+    int n = route.count();
+    auto at = [&](int i) -> const Point& {return (i == 0) ? start : route.at(i - 1);};
+    bool improved = true;
+    for (int pass = 0; improved && (pass < maxPasses); ++pass) {
+        improved = false;
+        for (int i = 1; i < n; ++i) {
+            for (int j = i + 1; j <= qMin(n, i + maxSegmentLength); ++j) {
+                // gain of reversing the segment at(i)..at(j)
+                qreal delta = distance(at(i - 1), at(j)) - distance(at(i - 1), at(i));
+                if (j < n) {
+                    delta += distance(at(i), at(j + 1)) - distance(at(j), at(j + 1));
+                }
+                if (delta < -1) { // ignore improvements below one nanometer
+                    std::reverse(route.begin() + i - 1, route.begin() + j);
+                    improved = true;
+                }
+            }
+        }
+    }
+}
+
+qreal ExcellonGenerator::distance(const Point& p1, const Point& p2) noexcept
+{
+    qreal dx = p2.getX().toNm() - p1.getX().toNm();
+    qreal dy = p2.getY().toNm() - p1.getY().toNm();
+    return qSqrt(dx * dx + dy * dy);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
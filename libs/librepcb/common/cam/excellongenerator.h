@@ -40,6 +40,10 @@ namespace librepcb {
 /**
  * @brief The ExcellonGenerator class
  *
+ * The holes are grouped by tool (sorted by diameter). Optionally, the hits of each tool
+ * are ordered to reduce the travel distance of the drill head, see
+ * #setRouteOptimization().
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -58,6 +62,29 @@ class ExcellonGenerator final
         // Getters
         const QString& toStr() const noexcept {return mOutput;}
 
+        /**
+         * @brief Get the travel distance of the drill head in the generated output
+         *
+         * This is the length of the path from the origin through all hits, in the order
+         * they were written by the last call of #generate().
+         *
+         * @return The total travel distance
+         */
+        const Length& getTravelDistance() const noexcept {return mTravelDistance;}
+
+        // Setters
+
+        /**
+         * @brief Enable or disable the optimization of the drill route (default: disabled)
+         *
+         * If enabled, the hits of each tool are ordered by a nearest-neighbour tour which
+         * is then improved with 2-opt moves. Otherwise the hits are written in the order
+         * they were added.
+         *
+         * @param enabled   Whether the route should be optimized or not
+         */
+        void setRouteOptimization(bool enabled) noexcept {mRouteOptimization = enabled;}
+
         // General Methods
         void drill(const Point& pos, const Length& dia) noexcept;
         void generate();
@@ -75,10 +102,18 @@ class ExcellonGenerator final
         void printDrills() noexcept;
         void printFooter() noexcept;
 
+        // Route Optimization
+        static QVector<Point> sortByNearestNeighbour(const QVector<Point>& hits,
+                                                     const Point& start) noexcept;
+        static void improveBy2Opt(QVector<Point>& route, const Point& start) noexcept;
+        static qreal distance(const Point& p1, const Point& p2) noexcept;
+
 
         // Excellon Data
         QString mOutput;
         QMultiMap<Length, Point> mDrillList;
+        bool mRouteOptimization;
+        Length mTravelDistance;
 };
 
 /*****************************************************************************************
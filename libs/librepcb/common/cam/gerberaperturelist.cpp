@@ -64,71 +64,95 @@ QString GerberApertureList::generateString() const noexcept
 
 int GerberApertureList::setCircle(const Length& dia, const Length& hole)
 {
-    return setCurrentAperture(generateCircle(dia, hole));
+    ApertureKey key(ApertureKey::Shape::Circle, dia, Length(0), Angle::deg0(), 0, hole);
+    int number = mApertureNumbers.value(key, -1);
+    if (number < 0) {
+        number = addAperture(key, generateCircle(dia, hole));
+    }
+    return number;
 }
 
 int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateRect(w, h, hole));
+        ApertureKey key(ApertureKey::Shape::Rect, w, h, Angle::deg0(), 0, hole);
+        int number = mApertureNumbers.value(key, -1);
+        return (number >= 0) ? number : addAperture(key, generateRect(w, h, hole));
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateRect(h, w, hole));
+        ApertureKey key(ApertureKey::Shape::Rect, h, w, Angle::deg0(), 0, hole);
+        int number = mApertureNumbers.value(key, -1);
+        return (number >= 0) ? number : addAperture(key, generateRect(h, w, hole));
     } else {
+        ApertureKey key(ApertureKey::Shape::RotatedRect, w, h, rot, 0, hole);
+        int number = mApertureNumbers.value(key, -1);
+        if (number >= 0) return number;
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
         if (hole > 0) {
             addMacro(generateRotatedRectMacroWithHole());
         } else {
             addMacro(generateRotatedRectMacro());
         }
-        return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+        return addAperture(key, generateRotatedRect(w, h, rot, hole));
     }
 }
 
 int GerberApertureList::setObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateObround(w, h, hole));
+        ApertureKey key(ApertureKey::Shape::Obround, w, h, Angle::deg0(), 0, hole);
+        int number = mApertureNumbers.value(key, -1);
+        return (number >= 0) ? number : addAperture(key, generateObround(w, h, hole));
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateObround(h, w, hole));
+        ApertureKey key(ApertureKey::Shape::Obround, h, w, Angle::deg0(), 0, hole);
+        int number = mApertureNumbers.value(key, -1);
+        return (number >= 0) ? number : addAperture(key, generateObround(h, w, hole));
     } else {
+        ApertureKey key(ApertureKey::Shape::RotatedObround, w, h, rot, 0, hole);
+        int number = mApertureNumbers.value(key, -1);
+        if (number >= 0) return number;
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
         if (hole > 0) {
             addMacro(generateRotatedObroundMacroWithHole());
         } else {
             addMacro(generateRotatedObroundMacro());
         }
-        return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+        return addAperture(key, generateRotatedObround(w, h, rot, hole));
     }
 }
 
 int GerberApertureList::setRegularPolygon(const Length& dia, int n, const Angle& rot, const Length& hole) noexcept
 {
-    if (n < 3 || n > 12) {
-        qWarning() << "Gerber Export: Specified number of vertices not supported by gerber specs:" << n;
-    }
     // Adjust rotation as its interpretation differs between LibrePCB and Gerber specs
     Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-    return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+    ApertureKey key(ApertureKey::Shape::RegularPolygon, dia, Length(0), grbRot, n, hole);
+    int number = mApertureNumbers.value(key, -1);
+    if (number < 0) {
+        if (n < 3 || n > 12) {
+            qWarning() << "Gerber Export: Specified number of vertices not supported by gerber specs:" << n;
+        }
+        number = addAperture(key, generateRegularPolygon(dia, n, grbRot, hole));
+    }
+    return number;
 }
 
 void GerberApertureList::reset() noexcept
 {
     //mApertureMacros.clear();
     mApertures.clear();
+    mApertureNumbers.clear();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept
+int GerberApertureList::addAperture(const ApertureKey& key, const QString& aperture) noexcept
 {
-    int number = mApertures.key(aperture, -1);
-    if (number < 0) {
-        number = mApertures.count() + 10; // 10 is the number of the first aperture
-        Q_ASSERT(!mApertures.contains(number));
-        mApertures.insert(number, aperture);
-    }
+    int number = mApertures.count() + 10; // 10 is the number of the first aperture
+    Q_ASSERT(!mApertures.contains(number));
+    Q_ASSERT(!mApertureNumbers.contains(key));
+    mApertures.insert(number, aperture);
+    mApertureNumbers.insert(key, number);
     return number;
 }
 
@@ -139,6 +163,35 @@ void GerberApertureList::addMacro(const QString& macro) noexcept
     }
 }
 
+/*****************************************************************************************
+ *  Struct GerberApertureList::ApertureKey
+ ****************************************************************************************/
+
+GerberApertureList::ApertureKey::ApertureKey(Shape s, const Length& w, const Length& h,
+                                             const Angle& rot, int n,
+                                             const Length& holeDia) noexcept :
+    shape(s), width(w), height(h), rotation(rot), vertices(n),
+    hole((holeDia > 0) ? holeDia : Length(0))
+{
+}
+
+bool GerberApertureList::ApertureKey::operator==(const ApertureKey& rhs) const noexcept
+{
+    return (shape == rhs.shape) && (width == rhs.width) && (height == rhs.height)
+        && (rotation == rhs.rotation) && (vertices == rhs.vertices) && (hole == rhs.hole);
+}
+
+uint qHash(const GerberApertureList::ApertureKey& key, uint seed) noexcept
+{
+    uint hash = ::qHash(static_cast<int>(key.shape), seed);
+    hash = (hash * 31) + ::qHash(key.width.toNm(), seed);
+    hash = (hash * 31) + ::qHash(key.height.toNm(), seed);
+    hash = (hash * 31) + ::qHash(key.rotation.toMicroDeg(), seed);
+    hash = (hash * 31) + ::qHash(key.vertices, seed);
+    hash = (hash * 31) + ::qHash(key.hole.toNm(), seed);
+    return hash;
+}
+
 /*****************************************************************************************
  *  Aperture Generator Methods
  ****************************************************************************************/
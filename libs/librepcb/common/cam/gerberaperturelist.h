@@ -41,6 +41,11 @@ namespace librepcb {
 /**
  * @brief The GerberApertureList class
  *
+ * Apertures are looked up by a structured description (shape, dimensions, rotation,
+ * hole) in a hash, so selecting an aperture does not depend on the number of already
+ * defined apertures. The aperture definition string is only generated once for every
+ * new aperture.
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -72,8 +77,30 @@ class GerberApertureList final
 
     private:
 
+        // Types
+
+        /**
+         * @brief Structured description of an aperture, used as key for the lookup
+         */
+        struct ApertureKey {
+            enum class Shape {Circle, Rect, Obround, RegularPolygon, RotatedRect,
+                              RotatedObround};
+
+            ApertureKey(Shape s, const Length& w, const Length& h, const Angle& rot,
+                        int n, const Length& holeDia) noexcept;
+            bool operator==(const ApertureKey& rhs) const noexcept;
+
+            Shape shape;
+            Length width;       ///< diameter for circles and regular polygons
+            Length height;      ///< 0 for circles and regular polygons
+            Angle rotation;     ///< 0 if the rotation is contained in width/height
+            int vertices;       ///< count of vertices of regular polygons, otherwise 0
+            Length hole;        ///< 0 if there is no hole
+        };
+        friend uint qHash(const ApertureKey& key, uint seed) noexcept;
+
         // Private Methods
-        int setCurrentAperture(const QString& aperture) noexcept;
+        int addAperture(const ApertureKey& key, const QString& aperture) noexcept;
         void addMacro(const QString& macro) noexcept;
 
         // Aperture Generator Methods
@@ -91,6 +118,7 @@ class GerberApertureList final
 
         QList<QString> mApertureMacros;
         QMap<int, QString> mApertures; ///< key: aperture number (>= 10); value: aperture definition
+        QHash<ApertureKey, int> mApertureNumbers; ///< reverse index of #mApertures
 };
 
 /*****************************************************************************************
@@ -26,6 +26,7 @@
 #include "../geometry/ellipse.h"
 #include "../geometry/path.h"
 #include "../fileio/smarttextfile.h"
+#include "../fileio/fileutils.h"
 #include "../application.h"
 #include "../toolbox.h"
 
@@ -34,6 +35,43 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Class GerberGenerator::OutputWriter
+ ****************************************************************************************/
+
+/**
+ * @brief Writes the output to a device and calculates its MD5 checksum on the fly
+ */
+class GerberGenerator::OutputWriter final
+{
+    public:
+        explicit OutputWriter(QIODevice& device) noexcept :
+            mDevice(device), mMd5(QCryptographicHash::Md5), mSuccess(true) {}
+
+        bool isSuccessful() const noexcept {return mSuccess;}
+        QByteArray getMd5Checksum() const noexcept {return mMd5.result().toHex();}
+
+        void write(const QByteArray& data) noexcept {
+            // according to the RS-274C standard, linebreaks are not included in the checksum
+            const char* begin = data.constData();
+            const char* end = begin + data.size();
+            while (begin < end) {
+                const char* lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin));
+                if (!lineEnd) lineEnd = end;
+                mMd5.addData(begin, lineEnd - begin);
+                begin = lineEnd + 1;
+            }
+            if (mDevice.write(data) != data.size()) {
+                mSuccess = false;
+            }
+        }
+
+    private:
+        QIODevice& mDevice;
+        QCryptographicHash mMd5;
+        bool mSuccess;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -204,11 +242,12 @@ void GerberGenerator::reset() noexcept
 
 void GerberGenerator::generate()
 {
-    mOutput.clear();
-    printHeader();
-    printApertureList();
-    printContent();
-    printFooter();
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    if (!writeOutput(buffer)) {
+        throw LogicError(__FILE__, __LINE__, buffer.errorString());
+    }
+    mOutput = QString::fromLatin1(buffer.data());
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const
@@ -218,6 +257,21 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const
     file->save(true);
 }
 
+void GerberGenerator::generateToFile(const FilePath& filepath)
+{
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    if ((!writeOutput(file)) || (!file.commit())) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -225,7 +279,7 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const
 void GerberGenerator::setCurrentAperture(int number) noexcept
 {
     if (number != mCurrentApertureNumber) {
-        mContent.append(QString("D%1*\n").arg(number));
+        mContent.append('D').append(QByteArray::number(number)).append("*\n");
         mCurrentApertureNumber = number;
     }
 }
@@ -273,14 +327,14 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D02*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    mContent.append('X').append(QByteArray::number(pos.getX().toNm()))
+            .append('Y').append(QByteArray::number(pos.getY().toNm())).append("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D01*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    mContent.append('X').append(QByteArray::number(pos.getX().toNm()))
+            .append('Y').append(QByteArray::number(pos.getY().toNm())).append("D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept
@@ -289,21 +343,31 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start, const Po
     if (!mMultiQuadrantArcModeOn) {
         diff.makeAbs(); // no sign allowed in single quadrant mode!
     }
-    mContent.append(QString("X%1Y%2I%3J%4D01*\n").arg(end.getX().toNmString(),
-                                                      end.getY().toNmString(),
-                                                      diff.getX().toNmString(),
-                                                      diff.getY().toNmString()));
+    mContent.append('X').append(QByteArray::number(end.getX().toNm()))
+            .append('Y').append(QByteArray::number(end.getY().toNm()))
+            .append('I').append(QByteArray::number(diff.getX().toNm()))
+            .append('J').append(QByteArray::number(diff.getY().toNm())).append("D01*\n");
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D03*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    mContent.append('X').append(QByteArray::number(pos.getX().toNm()))
+            .append('Y').append(QByteArray::number(pos.getY().toNm())).append("D03*\n");
 }
 
-void GerberGenerator::printHeader() noexcept
+bool GerberGenerator::writeOutput(QIODevice& device) noexcept
 {
-    mOutput.append("G04 --- HEADER BEGIN --- *\n");
+    OutputWriter writer(device);
+    printHeader(writer);
+    printApertureList(writer);
+    printContent(writer);
+    printFooter(writer);
+    return writer.isSuccessful();
+}
+
+void GerberGenerator::printHeader(OutputWriter& writer) noexcept
+{
+    writer.write("G04 --- HEADER BEGIN --- *\n");
 
     // add some X2 attributes
     QString appVersion = qApp->getAppVersion().toPrettyStr(3);
@@ -311,56 +375,49 @@ void GerberGenerator::printHeader() noexcept
     QString projId = mProjectId.remove(',');
     QString projUuid = mProjectUuid.toStr();
     QString projRevision = mProjectRevision.remove(',');
-    mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(appVersion));
-    mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-    mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(projId, projUuid, projRevision));
-    mOutput.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
-    //mOutput.append("%TF.FilePolarity,Positive*%\n");
+    writer.write(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(appVersion).toLatin1());
+    writer.write(QString("%TF.CreationDate,%1*%\n").arg(creationDate).toLatin1());
+    writer.write(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(projId, projUuid, projRevision).toLatin1());
+    writer.write("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
+    //writer.write("%TF.FilePolarity,Positive*%\n");
 
     // coordinate format specification:
     //  - leading zeros omitted
     //  - absolute coordinates
     //  - coordiante format "6.6" --> allows us to directly use LengthBase_t (nanometers)!
-    mOutput.append("%FSLAX66Y66*%\n");
+    writer.write("%FSLAX66Y66*%\n");
 
     // set unit to millimeters
-    mOutput.append("%MOMM*%\n");
+    writer.write("%MOMM*%\n");
 
     // start linear interpolation mode
-    mOutput.append("G01*\n");
+    writer.write("G01*\n");
 
     // use single quadrant arc mode
-    mOutput.append("G74*\n");
+    writer.write("G74*\n");
 
-    mOutput.append("G04 --- HEADER END --- *\n");
+    writer.write("G04 --- HEADER END --- *\n");
 }
 
-void GerberGenerator::printApertureList() noexcept
+void GerberGenerator::printApertureList(OutputWriter& writer) noexcept
 {
-    mOutput.append(mApertureList->generateString());
+    writer.write(mApertureList->generateString().toLatin1());
 }
 
-void GerberGenerator::printContent() noexcept
+void GerberGenerator::printContent(OutputWriter& writer) noexcept
 {
-    mOutput.append("G04 --- BOARD BEGIN --- *\n");
-    mOutput.append(mContent);
-    mOutput.append("G04 --- BOARD END --- *\n");
+    writer.write("G04 --- BOARD BEGIN --- *\n");
+    writer.write(mContent);
+    writer.write("G04 --- BOARD END --- *\n");
 }
 
-void GerberGenerator::printFooter() noexcept
+void GerberGenerator::printFooter(OutputWriter& writer) noexcept
 {
     // MD5 checksum over content
-    mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
+    writer.write("%TF.MD5," + writer.getMd5Checksum() + "*%\n");
 
     // end of file
-    mOutput.append("M02*\n");
-}
-
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept
-{
-    // according to the RS-274C standard, linebreaks are not included in the checksum
-    QString data = QString(mOutput).remove(QChar('\n'));
-    return QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+    writer.write("M02*\n");
 }
 
 /*****************************************************************************************
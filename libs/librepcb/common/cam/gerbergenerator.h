@@ -89,12 +89,28 @@ class GerberGenerator final
         void generate();
         void saveToFile(const FilePath& filepath) const;
 
+        /**
+         * @brief Generate the output and write it directly to a file
+         *
+         * In contrast to #generate() and #saveToFile(), the output is streamed to the
+         * file and the checksum is calculated while writing, so the whole output is
+         * never kept in memory. #toStr() is not updated by this method.
+         *
+         * @param filepath  The file to write (will be replaced atomically)
+         *
+         * @throw Exception If the file could not be written.
+         */
+        void generateToFile(const FilePath& filepath);
+
         // Operator Overloadings
         GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
 
 
     private:
 
+        // Types
+        class OutputWriter;
+
         // Private Methods
         void setCurrentAperture(int number) noexcept;
         void setRegionModeOn() noexcept;
@@ -108,11 +124,11 @@ class GerberGenerator final
         void linearInterpolateToPosition(const Point& pos) noexcept;
         void circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept;
         void flashAtPosition(const Point& pos) noexcept;
-        void printHeader() noexcept;
-        void printApertureList() noexcept;
-        void printContent() noexcept;
-        void printFooter() noexcept;
-        QString calcOutputMd5Checksum() const noexcept;
+        bool writeOutput(QIODevice& device) noexcept;
+        void printHeader(OutputWriter& writer) noexcept;
+        void printApertureList(OutputWriter& writer) noexcept;
+        void printContent(OutputWriter& writer) noexcept;
+        void printFooter(OutputWriter& writer) noexcept;
 
         // Static Methods
         static QString escapeString(const QString& str) noexcept;
@@ -125,7 +141,7 @@ class GerberGenerator final
 
         // Gerber Data
         QString mOutput;
-        QString mContent;
+        QByteArray mContent;    ///< ASCII only
         QScopedPointer<GerberApertureList> mApertureList;
         int mCurrentApertureNumber;
         bool mMultiQuadrantArcModeOn;
@@ -58,6 +58,7 @@ SOURCES += \
     fileio/filepath.cpp \
     fileio/fileutils.cpp \
     fileio/sexpression.cpp \
+    fileio/sexprsnapshotwriter.cpp \
     fileio/smartfile.cpp \
     fileio/smartsexprfile.cpp \
     fileio/smarttextfile.cpp \
@@ -156,6 +157,7 @@ HEADERS += \
     fileio/serializableobject.h \
     fileio/serializableobjectlist.h \
     fileio/sexpression.h \
+    fileio/sexprsnapshotwriter.h \
     fileio/smartfile.h \
     fileio/smartsexprfile.h \
     fileio/smarttextfile.h \
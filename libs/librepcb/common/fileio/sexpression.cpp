@@ -22,13 +22,259 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "sexpression.h"
-#include <sexpresso/sexpresso.hpp>
 
 /*****************************************************************************************
  *  Namespace
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Class SExpression::Parser
+ ****************************************************************************************/
+
+/**
+ * @brief Single-pass recursive descent parser working directly on the UTF-8 bytes
+ *
+ * Only the values of the nodes are converted to QString (one allocation per node), no
+ * intermediate representation of the whole file is created. The current line and column
+ * are tracked to provide useful error messages.
+ */
+class SExpression::Parser final
+{
+        Q_DECLARE_TR_FUNCTIONS(SExpression::Parser)
+
+    public:
+        Parser(const QByteArray& content, const FilePath& filePath) noexcept :
+            mFilePath(filePath), mPos(content.constData()),
+            mEnd(content.constData() + content.size()), mLineStart(mPos), mLine(1) {}
+
+        SExpression parseRoot() {
+            skipWhitespaces();
+            if ((mPos >= mEnd) || (*mPos != '(')) {
+                throwError(tr("File does not have a root list node."));
+            }
+            SExpression root = parseList(); // can throw
+            skipWhitespaces();
+            if (mPos < mEnd) {
+                throwError(tr("File does not have exactly one root node."));
+            }
+            return root;
+        }
+
+    private:
+        SExpression parseNode() {
+            switch (*mPos) {
+                case '(': return parseList(); // can throw
+                case '"': return parseString(); // can throw
+                default:  return parseToken(); // can throw
+            }
+        }
+
+        SExpression parseList() {
+            Q_ASSERT(*mPos == '(');
+            ++mPos;
+            skipWhitespaces();
+            if ((mPos >= mEnd) || isDelimiter(*mPos)) {
+                throwError(tr("List does not have a name."));
+            }
+            SExpression list(Type::List, QString::fromUtf8(mPos, tokenLength()));
+            list.mFilePath = mFilePath;
+            mPos += tokenLength();
+            forever {
+                skipWhitespaces();
+                if (mPos >= mEnd) {
+                    throwError(tr("Unexpected end of file, missing \")\"."));
+                } else if (*mPos == ')') {
+                    ++mPos;
+                    return list;
+                } else {
+                    list.mChildren.append(parseNode()); // can throw
+                }
+            }
+        }
+
+        SExpression parseToken() {
+            // Note: Tokens get the type Type::String for backward compatibility since
+            // the deserialization code uses isString() to check for non-list values.
+            int length = tokenLength();
+            SExpression token(Type::String, QString::fromUtf8(mPos, length));
+            token.mFilePath = mFilePath;
+            mPos += length;
+            return token;
+        }
+
+        SExpression parseString() {
+            Q_ASSERT(*mPos == '"');
+            const char* start = ++mPos;
+            QByteArray unescaped; // only used if the string contains escape sequences
+            while ((mPos < mEnd) && (*mPos != '"')) {
+                if (*mPos == '\\') {
+                    unescaped.append(start, mPos - start);
+                    if (++mPos >= mEnd) break;
+                    switch (*mPos) {
+                        case 'a': unescaped.append('\a'); break;
+                        case 'b': unescaped.append('\b'); break;
+                        case 'f': unescaped.append('\f'); break;
+                        case 'n': unescaped.append('\n'); break;
+                        case 'r': unescaped.append('\r'); break;
+                        case 't': unescaped.append('\t'); break;
+                        case 'v': unescaped.append('\v'); break;
+                        case '"': case '\'': case '\\': case '?': unescaped.append(*mPos); break;
+                        default: throwError(tr("Invalid escape sequence in string."));
+                    }
+                    start = mPos + 1;
+                } else if (*mPos == '\n') {
+                    newLine(mPos + 1);
+                }
+                ++mPos;
+            }
+            if (mPos >= mEnd) {
+                throwError(tr("Unexpected end of file, missing closing '\"'."));
+            }
+            QString value;
+            if (unescaped.isNull()) {
+                value = QString::fromUtf8(start, mPos - start);
+            } else {
+                unescaped.append(start, mPos - start);
+                value = QString::fromUtf8(unescaped);
+            }
+            ++mPos; // skip closing quote
+            SExpression string(Type::String, value);
+            string.mFilePath = mFilePath;
+            return string;
+        }
+
+        void skipWhitespaces() noexcept {
+            while (mPos < mEnd) {
+                if (*mPos == '\n') {
+                    newLine(mPos + 1);
+                } else if (*mPos == ';') { // comment until end of line
+                    while ((mPos < mEnd - 1) && (*(mPos + 1) != '\n')) ++mPos;
+                } else if (!isspace(static_cast<unsigned char>(*mPos))) {
+                    break;
+                }
+                ++mPos;
+            }
+        }
+
+        int tokenLength() const noexcept {
+            const char* end = mPos;
+            while ((end < mEnd) && (!isDelimiter(*end))) ++end;
+            return end - mPos;
+        }
+
+        static bool isDelimiter(char c) noexcept {
+            return isspace(static_cast<unsigned char>(c)) || (c == '(') || (c == ')') ||
+                   (c == '"') || (c == ';');
+        }
+
+        void newLine(const char* lineStart) noexcept {
+            ++mLine;
+            mLineStart = lineStart;
+        }
+
+        [[noreturn]] void throwError(const QString& msg) const {
+            int column = QString::fromUtf8(mLineStart, mPos - mLineStart).length() + 1;
+            const char* contentEnd = mPos;
+            while ((contentEnd < mEnd) && (*contentEnd != '\n') &&
+                   (contentEnd - mPos < 40)) ++contentEnd;
+            throw FileParseError(__FILE__, __LINE__, mFilePath, mLine, column,
+                                 QString::fromUtf8(mPos, contentEnd - mPos), msg);
+        }
+
+        const FilePath& mFilePath;
+        const char* mPos;
+        const char* mEnd;
+        const char* mLineStart;
+        int mLine;
+};
+
+/*****************************************************************************************
+ *  Class SExpression::Writer
+ ****************************************************************************************/
+
+/**
+ * @brief Buffered output for the serialization of S-Expressions
+ *
+ * If a device is given, the buffer gets flushed into the device each time it exceeds
+ * #sBufferSize bytes. Without device, the whole output is collected in the buffer.
+ */
+class SExpression::Writer final
+{
+        Q_DECLARE_TR_FUNCTIONS(SExpression::Writer)
+
+    public:
+        explicit Writer(QIODevice* device) noexcept : mDevice(device) {
+            if (mDevice) mBuffer.reserve(sBufferSize + 1024);
+        }
+
+        QByteArray& getBuffer() noexcept {return mBuffer;}
+
+        void write(char c) {
+            mBuffer.append(c);
+        }
+
+        void writeIndent(int indent) {
+            static const QByteArray spaces(64, ' ');
+            for (; indent > spaces.size(); indent -= spaces.size()) {
+                mBuffer.append(spaces);
+            }
+            mBuffer.append(spaces.constData(), indent);
+        }
+
+        void writeAscii(const QString& str) {
+            // only used for validated list names and tokens, which are pure ASCII
+            const QChar* data = str.constData();
+            for (int i = 0; i < str.length(); ++i) {
+                mBuffer.append(static_cast<char>(data[i].unicode()));
+            }
+        }
+
+        void writeEscapedString(const QString& str) {
+            // must be compatible with the escape sequences supported by the parser
+            QByteArray utf8 = str.toUtf8();
+            mBuffer.append('"');
+            for (const char c : utf8) {
+                switch (c) {
+                    case '\a': mBuffer.append("\\a", 2); break;
+                    case '\b': mBuffer.append("\\b", 2); break;
+                    case '\f': mBuffer.append("\\f", 2); break;
+                    case '\n': mBuffer.append("\\n", 2); break;
+                    case '\r': mBuffer.append("\\r", 2); break;
+                    case '\t': mBuffer.append("\\t", 2); break;
+                    case '\v': mBuffer.append("\\v", 2); break;
+                    case '"': case '\'': case '\\': case '?':
+                        mBuffer.append('\\');
+                        mBuffer.append(c);
+                        break;
+                    default: mBuffer.append(c); break;
+                }
+            }
+            mBuffer.append('"');
+        }
+
+        void flushIfFull() {
+            if (mDevice && (mBuffer.size() >= sBufferSize)) {
+                flush(); // can throw
+            }
+        }
+
+        void flush() {
+            if (mDevice && (!mBuffer.isEmpty())) {
+                if (mDevice->write(mBuffer) != mBuffer.size()) {
+                    throw RuntimeError(__FILE__, __LINE__, QString(tr(
+                        "Could not write S-Expression: %1")).arg(mDevice->errorString()));
+                }
+                mBuffer.resize(0); // keeps the allocated capacity
+            }
+        }
+
+    private:
+        static constexpr int sBufferSize = 64 * 1024;
+        QIODevice* mDevice;
+        QByteArray mBuffer;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -49,31 +295,6 @@ SExpression::SExpression(const SExpression& other) noexcept :
 {
 }
 
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath) :
-    mType(Type::List), mValue(), mFilePath(filePath)
-{
-    if (sexp.childCount() < 1) {
-        throw RuntimeError(__FILE__, __LINE__);
-    }
-
-    if (sexp.isSexp()) {
-        sexpresso::Sexp& first = sexp.getChild(0);
-        if (!first.isString()) {
-            throw RuntimeError(__FILE__, __LINE__);
-        }
-        mValue = QString::fromStdString(first.getString());
-        for(auto&& arg : sexp.arguments()) {
-            mChildren.append(SExpression(arg, filePath));
-        }
-    } else if (sexp.isString()) {
-        mValue = QString::fromStdString(sexp.getString());
-        mType = Type::String;
-    } else {
-        throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                             tr("Unknown node type."));
-    }
-}
-
 SExpression::~SExpression() noexcept
 {
 }
@@ -187,80 +408,131 @@ void SExpression::removeLineBreaks() noexcept
 }
 
 QString SExpression::toString(int indent) const
+{
+    return QString::fromUtf8(toByteArray(indent)); // can throw
+}
+
+QByteArray SExpression::toByteArray(int indent) const
+{
+    Writer writer(nullptr);
+    writeTo(writer, indent); // can throw
+    return writer.getBuffer();
+}
+
+void SExpression::writeToDevice(QIODevice& device, int indent) const
+{
+    Writer writer(&device);
+    writeTo(writer, indent); // can throw
+    writer.flush(); // can throw
+}
+
+/*****************************************************************************************
+ *  Operator Overloadings
+ ****************************************************************************************/
+
+SExpression& SExpression::operator=(const SExpression& rhs) noexcept
+{
+    mType = rhs.mType;
+    mValue = rhs.mValue;
+    mChildren = rhs.mChildren;
+    mFilePath = rhs.mFilePath;
+    return *this;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool SExpression::writeTo(Writer& writer, int indent) const
 {
     if (mType == Type::List) {
         if (!isValidListName(mValue)) {
             throw LogicError(__FILE__, __LINE__,
                 QString(tr("Invalid S-Expression list name: %1")).arg(mValue));
         }
-        QString str = '(' + mValue;
+        writer.write('(');
+        writer.writeAscii(mValue);
+        bool multiLine = false;
         for (int i = 0; i < mChildren.count(); ++i) {
             const SExpression& child = mChildren.at(i);
-            if ((!str.at(str.length()-1).isSpace()) && (!child.isLineBreak())) {
-                str += ' ';
-            }
-            bool nextChildIsLineBreak = (i < mChildren.count() - 1)
-                                        ? mChildren.at(i + 1).isLineBreak()
-                                        : true;
-            if (child.isLineBreak() && nextChildIsLineBreak) {
-                if (child.isLineBreak() && (i > 0) && mChildren.at(i - 1).isLineBreak()) {
-                    // too many line breaks ;)
+            bool prevChildIsLineBreak = (i > 0) && mChildren.at(i - 1).isLineBreak();
+            if (child.isLineBreak()) {
+                multiLine = true;
+                bool nextChildIsLineBreak = (i < mChildren.count() - 1)
+                                            ? mChildren.at(i + 1).isLineBreak()
+                                            : true;
+                if (!nextChildIsLineBreak) {
+                    writer.write('\n');
+                    writer.writeIndent(indent + 1);
+                } else if (!prevChildIsLineBreak) {
+                    writer.write('\n');
                 } else {
-                    str += '\n';
+                    // too many line breaks ;)
                 }
             } else {
-                str += child.toString(indent + 1);
+                if (!prevChildIsLineBreak) {
+                    writer.write(' ');
+                }
+                if (child.writeTo(writer, indent + 1)) { // can throw
+                    multiLine = true;
+                }
             }
         }
-        if (isMultiLineList()) {
-            str += '\n' + QString(' ').repeated(indent);
+        if (multiLine) {
+            writer.write('\n');
+            writer.writeIndent(indent);
         }
-        return str + ')';
+        writer.write(')');
+        writer.flushIfFull(); // can throw
+        return multiLine;
     } else if (mType == Type::Token) {
         if (!isValidToken(mValue)) {
             throw LogicError(__FILE__, __LINE__,
                 QString(tr("Invalid S-Expression token: %1")).arg(mValue));
         }
-        return mValue;
+        writer.writeAscii(mValue);
+        return false;
     } else if (mType == Type::String) {
-        return '"' + escapeString(mValue) + '"';
+        writer.writeEscapedString(mValue);
+        return false;
     } else if (mType == Type::LineBreak) {
-        return '\n' + QString(' ').repeated(indent);
+        writer.write('\n');
+        writer.writeIndent(indent);
+        return true;
     } else {
         throw LogicError(__FILE__, __LINE__);
     }
 }
 
-/*****************************************************************************************
- *  Operator Overloadings
- ****************************************************************************************/
-
-SExpression& SExpression::operator=(const SExpression& rhs) noexcept
-{
-    mType = rhs.mType;
-    mValue = rhs.mValue;
-    mChildren = rhs.mChildren;
-    mFilePath = rhs.mFilePath;
-    return *this;
-}
-
-/*****************************************************************************************
- *  Private Methods
- ****************************************************************************************/
-
-QString SExpression::escapeString(const QString& string) const noexcept
+bool SExpression::isValidListName(const QString& name) noexcept
 {
-    return QString::fromStdString(sexpresso::escape(string.toStdString()));
-}
-
-bool SExpression::isValidListName(const QString& name) const noexcept
-{
-    return QRegExp("[a-z][a-z0-9_]*").exactMatch(name);
+    // equivalent to the regex "[a-z][a-z0-9_]*", but much faster
+    if (name.isEmpty()) return false;
+    const QChar* data = name.constData();
+    if ((data[0] < 'a') || (data[0] > 'z')) return false;
+    for (int i = 1; i < name.length(); ++i) {
+        ushort c = data[i].unicode();
+        if (!(((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) || (c == '_'))) {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool SExpression::isValidToken(const QString& token) const noexcept
+bool SExpression::isValidToken(const QString& token) noexcept
 {
-    return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
+    // equivalent to the regex "[a-zA-Z0-9\\.:_-]+", but much faster
+    if (token.isEmpty()) return false;
+    const QChar* data = token.constData();
+    for (int i = 0; i < token.length(); ++i) {
+        ushort c = data[i].unicode();
+        if (!(((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+              ((c >= '0') && (c <= '9')) || (c == '.') || (c == ':') || (c == '_') ||
+              (c == '-'))) {
+            return false;
+        }
+    }
+    return true;
 }
 
 /*****************************************************************************************
@@ -289,19 +561,13 @@ SExpression SExpression::createLineBreak()
 
 SExpression SExpression::parse(const QString& str, const FilePath& filePath)
 {
-    std::string error;
-    sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-    if (error.empty()) {
-        if (tree.childCount() == 1) {
-            return SExpression(tree.getChild(0), filePath);
-        } else {
-            throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                                 tr("File does not have exactly one root node."));
-        }
-    } else {
-        throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                             QString::fromStdString(error));
-    }
+    return parse(str.toUtf8(), filePath);
+}
+
+SExpression SExpression::parse(const QByteArray& content, const FilePath& filePath)
+{
+    Parser parser(content, filePath);
+    return parser.parseRoot(); // can throw
 }
 
 /*****************************************************************************************
@@ -31,10 +31,6 @@
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 /*****************************************************************************************
@@ -137,6 +133,32 @@ class SExpression final
         void removeLineBreaks() noexcept;
         QString toString(int indent) const;
 
+        /**
+         * @brief Serialize the node (and all its children) into UTF-8 encoded bytes
+         *
+         * @param indent    Indentation level of this node
+         *
+         * @return The serialized S-Expression
+         *
+         * @throw LogicError    If the tree contains invalid list names or tokens.
+         */
+        QByteArray toByteArray(int indent) const;
+
+        /**
+         * @brief Serialize the node (and all its children) directly into a device
+         *
+         * The output is streamed through a small, fixed size buffer, so even for huge
+         * trees no big temporary string needs to be built in memory.
+         *
+         * @param device    The opened device to write into
+         * @param indent    Indentation level of this node
+         *
+         * @throw LogicError    If the tree contains invalid list names or tokens. Note
+         *                      that parts of the output may already be written then.
+         * @throw RuntimeError  If writing to the device failed.
+         */
+        void writeToDevice(QIODevice& device, int indent) const;
+
         // Operator Overloadings
         SExpression& operator=(const SExpression& rhs) noexcept;
 
@@ -147,14 +169,43 @@ class SExpression final
         static SExpression createLineBreak();
         static SExpression parse(const QString& str, const FilePath& filePath);
 
+        /**
+         * @brief Parse an S-Expression from the (UTF-8 encoded) content of a file
+         *
+         * The content is parsed in a single pass directly from the raw bytes into the
+         * DOM tree, so it's not needed to convert the whole file into a QString first.
+         * Lists get the type Type::List, all other values (quoted strings and
+         * unquoted tokens) get the type Type::String.
+         *
+         * @param content   The UTF-8 encoded file content
+         * @param filePath  The parsed file (used for error messages and stored in all
+         *                  created nodes)
+         *
+         * @return The root node (a list)
+         *
+         * @throw FileParseError    If the content is not a valid S-Expression. The
+         *                          exception contains line and column of the error.
+         */
+        static SExpression parse(const QByteArray& content, const FilePath& filePath);
+
+
+    private: // Types
+        class Parser;
+        class Writer;
+
 
     private: // Methods
         SExpression(Type type, const QString& value);
-        SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
 
-        QString escapeString(const QString& string) const noexcept;
-        bool isValidListName(const QString& name) const noexcept;
-        bool isValidToken(const QString& token) const noexcept;
+        /**
+         * @brief Write this node recursively into a writer
+         *
+         * @retval true     If line breaks were written (i.e. this is a multi line list)
+         * @retval false    If everything was written on a single line
+         */
+        bool writeTo(Writer& writer, int indent) const;
+        static bool isValidListName(const QString& name) noexcept;
+        static bool isValidToken(const QString& token) noexcept;
 
         /**
          * @brief Serialization template method
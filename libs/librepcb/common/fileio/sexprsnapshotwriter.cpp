@@ -0,0 +1,74 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "sexprsnapshotwriter.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+SExprSnapshotWriter::SExprSnapshotWriter(const QList<SmartSExprFile::Snapshot>& snapshots) noexcept :
+    QThread(nullptr), mSnapshots(snapshots)
+{
+}
+
+SExprSnapshotWriter::~SExprSnapshotWriter() noexcept
+{
+    // never abort writing, otherwise the files would be left in an inconsistent state
+    wait();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SExprSnapshotWriter::run() noexcept
+{
+    QStringList errors;
+    for (int i = 0; i < mSnapshots.count(); ++i) {
+        try {
+            mSnapshots.at(i).write(); // can throw
+        } catch (const Exception& e) {
+            // continue with the other files, like Project#save() does
+            errors.append(e.getMsg());
+        }
+        emit progressUpdate((100 * (i + 1)) / mSnapshots.count());
+    }
+
+    if (errors.isEmpty()) {
+        emit succeeded(mSnapshots.count());
+    } else {
+        emit failed(errors.join("\n"));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_SEXPRSNAPSHOTWRITER_H
+#define LIBREPCB_SEXPRSNAPSHOTWRITER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "smartsexprfile.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class SExprSnapshotWriter
+ ****************************************************************************************/
+
+/**
+ * @brief The SExprSnapshotWriter class writes a list of SmartSExprFile::Snapshot objects
+ *        to the file system in a separate thread
+ *
+ * This allows to capture the state of DOM objects quickly in the main thread (see
+ * SmartSExprFile#createSnapshot()) while the (expensive) formatting and writing of the
+ * files does not block the user interface.
+ *
+ * All signals are emitted from the writer thread, so they should be connected with
+ * Qt::QueuedConnection to receivers living in another thread.
+ *
+ * @note The destructor waits until all files are written, i.e. the writer is never
+ *       interrupted in the middle of a file.
+ */
+class SExprSnapshotWriter final : public QThread
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        SExprSnapshotWriter() = delete;
+        SExprSnapshotWriter(const SExprSnapshotWriter& other) = delete;
+        explicit SExprSnapshotWriter(const QList<SmartSExprFile::Snapshot>& snapshots) noexcept;
+        ~SExprSnapshotWriter() noexcept;
+
+        // Operator Overloadings
+        SExprSnapshotWriter& operator=(const SExprSnapshotWriter& rhs) = delete;
+
+
+    signals:
+
+        void progressUpdate(int percent);
+        void succeeded(int fileCount);
+        void failed(QString errorMsg);
+
+
+    private: // Methods
+
+        void run() noexcept override;
+
+
+    private: // Data
+        const QList<SmartSExprFile::Snapshot> mSnapshots;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_SEXPRSNAPSHOTWRITER_H
@@ -36,7 +36,7 @@ namespace librepcb {
 SmartFile::SmartFile(const FilePath& filepath, bool restore, bool readOnly, bool create) :
     mFilePath(filepath), mTmpFilePath(filepath.toStr() % '~'),
     mOpenedFilePath(filepath), mIsRestored(restore), mIsReadOnly(readOnly),
-    mIsCreated(create)
+    mIsCreated(create), mIsOriginalModified(create), mIsBackupModified(create)
 {
     if (create)
     {
@@ -56,6 +56,7 @@ SmartFile::SmartFile(const FilePath& filepath, bool restore, bool readOnly, bool
         // decide if we open the original file (*.*) or the backup (*.*~)
         if ((mIsRestored) && (mTmpFilePath.isExistingFile())) {
             mOpenedFilePath = mTmpFilePath;
+            mIsOriginalModified = true; // the original file is older than the backup
         }
 
         // check if the file exists
@@ -114,6 +115,73 @@ void SmartFile::updateMembersAfterSaving(bool toOriginal) noexcept
 
     if (toOriginal && mIsCreated)
         mIsCreated = false;
+
+    if (toOriginal)
+        mIsOriginalModified = false;
+    else
+        mIsBackupModified = false;
+}
+
+void SmartFile::setLoadedContent(const QByteArray& content) noexcept
+{
+    FileState& state = (mOpenedFilePath == mTmpFilePath) ? mBackupFileState
+                                                         : mOriginalFileState;
+    state = getFileState(mOpenedFilePath,
+                         QCryptographicHash::hash(content, QCryptographicHash::Sha1));
+}
+
+void SmartFile::saveContent(const QByteArray& content, bool toOriginal)
+{
+    const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal); // can throw
+    FileState& state = toOriginal ? mOriginalFileState : mBackupFileState;
+    writeFileIfChanged(filepath, content, state); // can throw
+    updateMembersAfterSaving(toOriginal);
+}
+
+/*****************************************************************************************
+ *  Protected Static Methods
+ ****************************************************************************************/
+
+bool SmartFile::writeFileIfChanged(const FilePath& filepath, const QByteArray& content,
+                                   FileState& state)
+{
+    QByteArray newHash = QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+    if (isFileUpToDate(filepath, newHash, state)) { // can throw
+        return false; // the file is up to date, don't touch it
+    }
+    FileUtils::writeFile(filepath, content); // can throw
+    state = getFileState(filepath, newHash);
+    return true;
+}
+
+bool SmartFile::isFileUpToDate(const FilePath& filepath, const QByteArray& contentHash,
+                               FileState& state)
+{
+    if (!filepath.isExistingFile()) {
+        return false;
+    }
+    FileState currentState = getFileState(filepath, state.contentHash);
+    if ((state.contentHash.isEmpty()) || (currentState.size != state.size) ||
+        (currentState.lastModified != state.lastModified))
+    {
+        // the current content is not known or the file was modified by someone
+        // else, but reading is still cheaper than writing
+        currentState.contentHash = QCryptographicHash::hash(
+            FileUtils::readFile(filepath), QCryptographicHash::Sha1); // can throw
+    }
+    state = currentState;
+    return (state.contentHash == contentHash);
+}
+
+SmartFile::FileState SmartFile::getFileState(const FilePath& filepath,
+                                             const QByteArray& contentHash) noexcept
+{
+    QFileInfo info(filepath.toStr());
+    FileState state;
+    state.contentHash = contentHash;
+    state.size = info.size();
+    state.lastModified = info.lastModified();
+    return state;
 }
 
 /*****************************************************************************************
@@ -45,6 +45,8 @@ namespace librepcb {
  *    are possible to that file)
  *  - Creation of backup files ('~' at the end of the filename)
  *  - Restoring backup files
+ *  - Keeping track whether the original file and the backup file are up to date
+ *  - Skipping writes of unchanged content (to keep the file modification time)
  *  - Helper methods for subclasses to load/save files
  *
  * @note See @ref doc_project_save for more details about the backup/restore feature.
@@ -60,6 +62,22 @@ class SmartFile
 
     public:
 
+        // Types
+
+        /**
+         * @brief The known state of a file on the file system
+         *
+         * The hash of the content is only trusted as long as the size and the
+         * modification time of the file are unchanged, so modifications done by other
+         * applications (e.g. a version control system) are detected.
+         */
+        struct FileState {
+            QByteArray contentHash; ///< SHA-1 hash of the content (empty if not known)
+            qint64 size = -1;       ///< size of the file in bytes
+            QDateTime lastModified; ///< modification time of the file
+        };
+
+
         // Constructors / Destructor
         SmartFile() = delete;
         SmartFile(const SmartFile& other) = delete;
@@ -125,6 +143,31 @@ class SmartFile
          */
         bool isCreated() const noexcept {return mIsCreated;}
 
+        /**
+         * @brief Check if the content was modified since the file was written the last time
+         *
+         * The owner of the file can use this to skip serializing and saving a file which
+         * is still up to date.
+         *
+         * @param original  Specifies whether the original or the backup file is checked.
+         *
+         * @return true if the file needs to be saved, false if it is up to date
+         *
+         * @see #setModified()
+         */
+        bool isModified(bool original) const noexcept {
+            return original ? mIsOriginalModified : mIsBackupModified;
+        }
+
+
+        // Setters
+
+        /**
+         * @brief Mark the content as modified, so both the original file and the backup
+         *        file are considered as outdated until they are saved again
+         */
+        void setModified() noexcept {mIsOriginalModified = mIsBackupModified = true;}
+
 
         // General Methods
 
@@ -167,7 +210,8 @@ class SmartFile
         const FilePath& prepareSaveAndReturnFilePath(bool toOriginal);
 
         /**
-         * @brief Update the member variables #mIsRestored and #mIsCreated after saving
+         * @brief Update the member variables #mIsRestored, #mIsCreated,
+         *        #mIsOriginalModified and #mIsBackupModified after saving
          *
          * @note This method must be called from all subclasses AFTER saving the changes
          *       to the file!
@@ -176,6 +220,85 @@ class SmartFile
          */
         void updateMembersAfterSaving(bool toOriginal) noexcept;
 
+        /**
+         * @brief Remember the content which was loaded from #mOpenedFilePath
+         *
+         * Subclasses should call this after reading the file, so #saveContent() does not
+         * need to write the file again if its content was not changed.
+         *
+         * @param content   The raw content of the loaded file
+         */
+        void setLoadedContent(const QByteArray& content) noexcept;
+
+        /**
+         * @brief Save the content to the original or backup file, if it has changed
+         *
+         * This method calls #prepareSaveAndReturnFilePath() and
+         * #updateMembersAfterSaving(), so subclasses don't need to do that. If the file
+         * still contains exactly the passed content, it is not touched at all (see
+         * #writeFileIfChanged()).
+         *
+         * @param content       The new content of the file
+         * @param toOriginal    Specifies whether the original or the backup file should
+         *                      be overwritten/created.
+         *
+         * @throw Exception If an error occurs
+         */
+        void saveContent(const QByteArray& content, bool toOriginal);
+
+
+        // Protected Static Methods
+
+        /**
+         * @brief Write a file, unless it already contains the passed content
+         *
+         * Skipping the write keeps the modification time of the file, which avoids
+         * needless work of file watchers (e.g. file synchronization or version control
+         * tools).
+         *
+         * @param filepath      The file to write
+         * @param content       The new content of the file
+         * @param state         The known state of the file. If it is unknown or the file
+         *                      was modified in the meantime, the existing file is read
+         *                      to compare it. Updated to the state of the file afterwards.
+         *
+         * @return True if the file was written, false if it was already up to date
+         *
+         * @throw Exception If an error occurs
+         */
+        static bool writeFileIfChanged(const FilePath& filepath, const QByteArray& content,
+                                       FileState& state);
+
+        /**
+         * @brief Check whether a file already contains the content with the passed hash
+         *
+         * This allows subclasses to skip writing files without having the whole new
+         * content in memory (see #writeFileIfChanged()).
+         *
+         * @param filepath      The file to check
+         * @param contentHash   The SHA-1 hash of the new content of the file
+         * @param state         The known state of the file. If it is unknown or the file
+         *                      was modified in the meantime, the existing file is read
+         *                      to compare it. Updated to the current state of the file.
+         *
+         * @return True if the file exists and contains exactly this content
+         *
+         * @throw Exception If an error occurs
+         */
+        static bool isFileUpToDate(const FilePath& filepath, const QByteArray& contentHash,
+                                   FileState& state);
+
+        /**
+         * @brief Get the current state of a file with the specified content hash
+         *
+         * @param filepath      The file to check
+         * @param contentHash   The hash of the content of the file
+         *
+         * @return The state of the file
+         */
+        static FileState getFileState(const FilePath& filepath,
+                                      const QByteArray& contentHash) noexcept;
+
 
         // General Attributes
 
@@ -221,6 +344,30 @@ class SmartFile
          */
         bool mIsCreated;
 
+        /**
+         * @brief If true, the original file is outdated and needs to be saved
+         *
+         * This is initially true for created files and files restored from a backup.
+         */
+        bool mIsOriginalModified;
+
+        /**
+         * @brief If true, the backup file is outdated and needs to be saved
+         *
+         * This is initially true for created files only.
+         */
+        bool mIsBackupModified;
+
+        /**
+         * @brief The state of the original file, as it was loaded or saved the last time
+         */
+        FileState mOriginalFileState;
+
+        /**
+         * @brief Same as #mOriginalFileState, but for the backup file
+         */
+        FileState mBackupFileState;
+
 };
 
 /*****************************************************************************************
@@ -30,6 +30,37 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Class SmartSExprFile::HashDevice
+ ****************************************************************************************/
+
+/**
+ * @brief A write-only device which calculates the SHA-1 hash of all written data
+ */
+class SmartSExprFile::HashDevice final : public QIODevice
+{
+    public:
+        HashDevice() noexcept : QIODevice(), mHash(QCryptographicHash::Sha1) {
+            open(QIODevice::WriteOnly);
+        }
+
+        QByteArray getResult() const noexcept {return mHash.result();}
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize) noexcept override {
+            Q_UNUSED(data); Q_UNUSED(maxSize);
+            return -1;
+        }
+
+        qint64 writeData(const char* data, qint64 size) noexcept override {
+            mHash.addData(data, static_cast<int>(size));
+            return size;
+        }
+
+    private:
+        QCryptographicHash mHash;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -47,22 +78,115 @@ SmartSExprFile::~SmartSExprFile() noexcept
  *  General Methods
  ****************************************************************************************/
 
-SExpression SmartSExprFile::parseFileAndBuildDomTree() const
+SExpression SmartSExprFile::parseFileAndBuildDomTree()
 {
-    return SExpression::parse(FileUtils::readFile(mOpenedFilePath), mOpenedFilePath);
+    QByteArray content = FileUtils::readFile(mOpenedFilePath); // can throw
+    setLoadedContent(content);
+    return SExpression::parse(content, mOpenedFilePath);
 }
 
 void SmartSExprFile::save(const SExpression& domDocument, bool toOriginal)
 {
-    FilePath filepath = prepareSaveAndReturnFilePath(toOriginal); // can throw
-    QString content = domDocument.toString(0); // can throw
-    if (!content.endsWith('\n')) {
-        content.append('\n');
+    const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal); // can throw
+    if (!toOriginal) {
+        takeSnapshotFileState();
     }
-    FileUtils::writeFile(filepath, content.toUtf8()); // can throw
+    FileState& state = toOriginal ? mOriginalFileState : mBackupFileState;
+    writeDomTreeIfChanged(filepath, domDocument, state); // can throw
     updateMembersAfterSaving(toOriginal);
 }
 
+SmartSExprFile::Snapshot SmartSExprFile::createSnapshot(const SExpression& domDocument)
+{
+    const FilePath& filepath = prepareSaveAndReturnFilePath(false); // can throw
+    takeSnapshotFileState();
+    // the snapshot updates the state of the backup file after writing it
+    mSnapshotFileState = std::make_shared<SharedFileState>();
+    mSnapshotFileState->state = mBackupFileState;
+    Snapshot snapshot(filepath, domDocument, mSnapshotFileState);
+    updateMembersAfterSaving(false); // the snapshot is considered as saved
+    return snapshot;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void SmartSExprFile::takeSnapshotFileState() noexcept
+{
+    if (mSnapshotFileState) {
+        QMutexLocker locker(&mSnapshotFileState->mutex);
+        mBackupFileState = mSnapshotFileState->state;
+    }
+    mSnapshotFileState.reset(); // later writes of the snapshot are outdated anyway
+}
+
+/*****************************************************************************************
+ *  Class SmartSExprFile::Snapshot
+ ****************************************************************************************/
+
+bool SmartSExprFile::Snapshot::write() const
+{
+    FileState fileState;
+    {
+        QMutexLocker locker(&mFileState->mutex);
+        fileState = mFileState->state;
+    }
+    bool written;
+    try {
+        written = writeDomTreeIfChanged(mFilePath, mRoot, fileState); // can throw
+    } catch (...) {
+        fileState = FileState(); // the state of the file is unknown now
+        QMutexLocker locker(&mFileState->mutex);
+        mFileState->state = fileState;
+        throw;
+    }
+    QMutexLocker locker(&mFileState->mutex);
+    mFileState->state = fileState;
+    return written;
+}
+
+/*****************************************************************************************
+ *  Private Static Methods
+ ****************************************************************************************/
+
+bool SmartSExprFile::writeDomTreeIfChanged(const FilePath& filepath,
+                                           const SExpression& root, FileState& state)
+{
+    // first pass: only calculate the hash, the file is not touched if it is up to date
+    HashDevice hashDevice;
+    writeDomTree(root, hashDevice); // can throw
+    QByteArray newHash = hashDevice.getResult();
+    if (isFileUpToDate(filepath, newHash, state)) { // can throw
+        return false;
+    }
+
+    // second pass: stream the content directly into the file
+    FileUtils::makePath(filepath.getParentDir()); // can throw
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__,
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    writeDomTree(root, file); // can throw (the file is discarded then)
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
+    state = getFileState(filepath, newHash);
+    return true;
+}
+
+void SmartSExprFile::writeDomTree(const SExpression& root, QIODevice& device)
+{
+    root.writeToDevice(device, 0); // can throw
+    if (device.write("\n", 1) != 1) { // the root list always ends with ')'
+        throw RuntimeError(__FILE__, __LINE__, QString(tr("Could not write S-Expression: "
+            "%1")).arg(device.errorString()));
+    }
+}
+
 /*****************************************************************************************
  *  Static Methods
  ****************************************************************************************/
@@ -26,14 +26,13 @@
 #include <memory>
 #include <QtCore>
 #include "smartfile.h"
+#include "sexpression.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class SExpression;
-
 /*****************************************************************************************
  *  Class SmartSExprFile
  ****************************************************************************************/
@@ -56,6 +55,63 @@ class SmartSExprFile final : public SmartFile
 
     public:
 
+        // Types
+
+        /**
+         * @brief The state of a file, shared between a #Snapshot and its #SmartSExprFile
+         *
+         * The snapshot updates it after writing the file (in any thread), and the
+         * #SmartSExprFile object takes it over the next time it writes the backup file.
+         * All members must only be accessed with #mutex locked.
+         */
+        struct SharedFileState {
+            QMutex mutex;
+            FileState state;
+        };
+
+        /**
+         * @brief A DOM tree captured by #createSnapshot() which is ready to be written
+         *
+         * The snapshot holds a (cheap, implicitly shared) copy of the DOM tree and the
+         * path of the file to write, but no reference to the #SmartSExprFile object. So
+         * #write() can be called from any thread, for example to save backups in the
+         * background while the DOM objects are modified in the main thread.
+         */
+        class Snapshot final
+        {
+            public:
+                Snapshot(const FilePath& filepath, const SExpression& root,
+                         const FileState& fileState = FileState()) noexcept :
+                    mFilePath(filepath), mRoot(root),
+                    mFileState(std::make_shared<SharedFileState>()) {
+                    mFileState->state = fileState;
+                }
+                Snapshot(const FilePath& filepath, const SExpression& root,
+                         const std::shared_ptr<SharedFileState>& fileState) noexcept :
+                    mFilePath(filepath), mRoot(root), mFileState(fileState) {}
+
+                const FilePath& getFilePath() const noexcept {return mFilePath;}
+
+                /**
+                 * @brief Format the DOM tree and write it to the file system
+                 *
+                 * The file is not touched if it already contains exactly this content.
+                 * Afterwards, the shared state of the file is updated, so the next
+                 * snapshot does not need to read the file to compare it.
+                 *
+                 * @return True if the file was written, false if it was up to date
+                 *
+                 * @throw Exception If an error occurs
+                 */
+                bool write() const;
+
+            private:
+                FilePath mFilePath;
+                SExpression mRoot;
+                std::shared_ptr<SharedFileState> mFileState; ///< see #SharedFileState
+        };
+
+
         // Constructors / Destructor
         SmartSExprFile() = delete;
         SmartSExprFile(const SmartSExprFile& other) = delete;
@@ -90,11 +146,14 @@ class SmartSExprFile final : public SmartFile
          * @return  A pointer to the created DOM tree. The caller takes the ownership of
          *          the DOM document.
          */
-        SExpression parseFileAndBuildDomTree() const;
+        SExpression parseFileAndBuildDomTree();
 
         /**
          * @brief Write the S-Expressions DOM tree to the file system
          *
+         * The DOM tree is streamed directly into the file. If the file already contains
+         * exactly the same content, it is not written again (see #writeDomTreeIfChanged()).
+         *
          * @param domDocument   The DOM document to save
          * @param toOriginal    Specifies whether the original or the backup file should
          *                      be overwritten/created.
@@ -103,6 +162,24 @@ class SmartSExprFile final : public SmartFile
          */
         void save(const SExpression& domDocument, bool toOriginal);
 
+        /**
+         * @brief Capture the S-Expressions DOM tree to write it later
+         *
+         * In contrast to #save(), the (expensive) formatting and writing of the file is
+         * not done here, but by Snapshot#write(). This is only allowed for the backup
+         * file, which is considered as up to date afterwards (see #isModified()).
+         *
+         * The state of the backup file known after writing the snapshot is taken over
+         * by the next call of #createSnapshot() or #save().
+         *
+         * @param domDocument   The DOM document to save
+         *
+         * @return The snapshot to write to the backup file
+         *
+         * @throw Exception If the file was opened in read-only mode
+         */
+        Snapshot createSnapshot(const SExpression& domDocument);
+
 
         // Operator Overloadings
         SmartSExprFile& operator=(const SmartSExprFile& rhs) = delete;
@@ -140,6 +217,53 @@ class SmartSExprFile final : public SmartFile
          */
         SmartSExprFile(const FilePath& filepath, bool restore, bool readOnly, bool create);
 
+        /**
+         * @brief Format a DOM tree and write it to a file, if the content has changed
+         *
+         * The DOM tree is formatted twice: First only to calculate the hash of the new
+         * content (see SmartFile#isFileUpToDate()), and then (only if needed) directly
+         * into the file. So even for huge files the formatted content is never held in
+         * memory as a whole.
+         *
+         * @param filepath  The file to write
+         * @param root      The DOM tree to write
+         * @param state     See SmartFile#writeFileIfChanged()
+         *
+         * @return True if the file was written, false if it was already up to date
+         *
+         * @throw Exception If an error occurs
+         */
+        static bool writeDomTreeIfChanged(const FilePath& filepath, const SExpression& root,
+                                          FileState& state);
+
+        /**
+         * @brief Format a DOM tree to the content of a S-Expressions file
+         *
+         * @param root      The DOM tree to format
+         * @param device    The opened device to write the content into
+         *
+         * @throw Exception If an error occurs
+         */
+        static void writeDomTree(const SExpression& root, QIODevice& device);
+
+        /**
+         * @brief Take over the state of the backup file from the last written snapshot
+         */
+        void takeSnapshotFileState() noexcept;
+
+
+    private: // Types
+
+        class HashDevice;
+
+
+    private: // Data
+
+        /**
+         * @brief The state shared with the last snapshot (nullptr if already taken over)
+         */
+        std::shared_ptr<SharedFileState> mSnapshotFileState;
+
 };
 
 /*****************************************************************************************
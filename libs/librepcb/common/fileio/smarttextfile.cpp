@@ -41,6 +41,7 @@ SmartTextFile::SmartTextFile(const FilePath& filepath, bool restore, bool readOn
     } else {
         // read the content of the file
         mContent = FileUtils::readFile(mOpenedFilePath);
+        setLoadedContent(mContent);
     }
 }
 
@@ -54,9 +55,7 @@ SmartTextFile::~SmartTextFile() noexcept
 
 void SmartTextFile::save(bool toOriginal)
 {
-    const FilePath& filepath = prepareSaveAndReturnFilePath(toOriginal);
-    FileUtils::writeFile(filepath, mContent);
-    updateMembersAfterSaving(toOriginal);
+    saveContent(mContent, toOriginal); // can throw
 }
 
 /*****************************************************************************************
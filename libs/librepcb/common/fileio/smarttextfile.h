@@ -93,7 +93,12 @@ class SmartTextFile final : public SmartFile
          *
          * @param content   The new content of the file
          */
-        void setContent(const QByteArray& content) noexcept {mContent = content;}
+        void setContent(const QByteArray& content) noexcept {
+            if (content != mContent) {
+                mContent = content;
+                setModified();
+            }
+        }
 
 
         // General Methods
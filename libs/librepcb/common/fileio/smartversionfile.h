@@ -94,7 +94,12 @@ class SmartVersionFile final : public SmartFile
          *
          * @param version   The new version of the file
          */
-        void setVersion(const Version& version) noexcept {mVersion = version;}
+        void setVersion(const Version& version) noexcept {
+            if (version != mVersion) {
+                mVersion = version;
+                setModified();
+            }
+        }
 
 
         // General Methods
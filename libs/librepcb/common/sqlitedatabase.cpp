@@ -92,6 +92,7 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath) :
 
 SQLiteDatabase::~SQLiteDatabase() noexcept
 {
+    mQueryCache.clear(); // cached queries must be released before closing the database
     mDb.close();
 }
 
@@ -146,6 +147,15 @@ void SQLiteDatabase::clearTable(const QString& table)
     exec("DELETE FROM " % table); // can throw
 }
 
+bool SQLiteDatabase::isExistingTable(const QString& table)
+{
+    QSqlQuery query = prepareQuery(
+        "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = :name");
+    query.bindValue(":name", table);
+    exec(query); // can throw
+    return query.first() && (query.value(0).toInt() > 0);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -162,6 +172,15 @@ QSqlQuery SQLiteDatabase::prepareQuery(const QString& query) const
     return q;
 }
 
+QSqlQuery SQLiteDatabase::prepareCachedQuery(const QString& query)
+{
+    auto it = mQueryCache.find(query);
+    if (it == mQueryCache.end()) {
+        it = mQueryCache.insert(query, prepareQuery(query)); // can throw
+    }
+    return it.value();
+}
+
 int SQLiteDatabase::insert(QSqlQuery& query)
 {
     exec(query); // can throw
@@ -176,6 +195,40 @@ int SQLiteDatabase::insert(QSqlQuery& query)
     }
 }
 
+void SQLiteDatabase::insertMultiple(const QString& table, const QStringList& columns,
+                                    const QList<QVariantList>& rows)
+{
+    Q_ASSERT(columns.count() > 0);
+    int rowsPerStatement = qMax(1, sMaxVariableNumber / columns.count());
+    QStringList placeholderList;
+    for (int i = 0; i < columns.count(); ++i) {
+        placeholderList.append("?");
+    }
+    QString placeholders = "(" % placeholderList.join(", ") % ")";
+    for (int first = 0; first < rows.count(); first += rowsPerStatement) {
+        int count = qMin(rowsPerStatement, rows.count() - first);
+        QStringList values;
+        for (int i = 0; i < count; ++i) {
+            values.append(placeholders);
+        }
+        QString sql = "INSERT INTO " % table % " (" % columns.join(", ") % ") VALUES " %
+                      values.join(", ");
+        // only the statement for full batches is cached, otherwise every different
+        // number of remaining rows would add another (big) statement to the cache
+        QSqlQuery query = (count == rowsPerStatement) ? prepareCachedQuery(sql)
+                                                      : prepareQuery(sql); // can throw
+        int index = 0;
+        for (int i = first; i < first + count; ++i) {
+            const QVariantList& row = rows.at(i);
+            Q_ASSERT(row.count() == columns.count());
+            foreach (const QVariant& value, row) {
+                query.bindValue(index++, value);
+            }
+        }
+        exec(query); // can throw
+    }
+}
+
 void SQLiteDatabase::exec(QSqlQuery& query)
 {
     if (!query.exec()) {
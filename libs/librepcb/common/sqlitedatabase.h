@@ -78,10 +78,60 @@ class SQLiteDatabase final : public QObject
         void rollbackTransaction();
         void clearTable(const QString& table);
 
+        /**
+         * @brief Check whether a table (or virtual table) exists in the database
+         *
+         * @param table     Name of the table
+         *
+         * @return True if the table exists, false if not
+         *
+         * @throw Exception If the database could not be queried.
+         */
+        bool isExistingTable(const QString& table);
+
 
         // General Methods
         QSqlQuery prepareQuery(const QString& query) const;
+
+        /**
+         * @brief Get a prepared query from the statement cache
+         *
+         * The query is prepared only the first time it is requested, afterwards the
+         * cached query (keyed by the SQL text) is returned. This avoids parsing the same
+         * SQL statement again and again when executing it many times (e.g. in loops).
+         *
+         * @warning The returned object shares its state with the cached query, so do not
+         *          use the same SQL text for nested queries (e.g. executing a query
+         *          while still iterating over the results of the same query)!
+         *
+         * @param query     The SQL query text
+         *
+         * @return The prepared query
+         *
+         * @throw Exception If the query could not be prepared.
+         */
+        QSqlQuery prepareCachedQuery(const QString& query);
+
         int insert(QSqlQuery& query);
+
+        /**
+         * @brief Insert multiple rows into a table with as few statements as possible
+         *
+         * The rows are inserted with multi-row "INSERT INTO ... VALUES (...), (...)"
+         * statements. The statement for full batches is cached (see
+         * #prepareCachedQuery()), only the one for the remaining rows is not. This is
+         * much faster than inserting every row with its own statement.
+         *
+         * @param table     Name of the table
+         * @param columns   Names of the columns to insert
+         * @param rows      The values to insert, each row must contain exactly one value
+         *                  for every column
+         *
+         * @throw Exception If the insertion failed.
+         */
+        void insertMultiple(const QString& table, const QStringList& columns,
+                            const QList<QVariantList>& rows);
+
         void exec(QSqlQuery& query);
         void exec(const QString& query);
 
@@ -116,7 +166,15 @@ class SQLiteDatabase final : public QObject
     private: // Data
 
         QSqlDatabase mDb;
+        QHash<QString, QSqlQuery> mQueryCache;   ///< see #prepareCachedQuery()
         //int mNestedTransactionCount;
+
+        /**
+         * @brief Maximum number of bound parameters per statement
+         *
+         * @see https://www.sqlite.org/limits.html#max_variable_number
+         */
+        static const int sMaxVariableNumber = 999;
 };
 
 /*****************************************************************************************
@@ -45,6 +45,29 @@ void ClipperHelpers::offset(ClipperLib::Paths& paths, const Length& offset,
     }
 }
 
+ClipperLib::IntRect ClipperHelpers::getBoundingRect(const ClipperLib::Paths& paths) noexcept
+{
+    ClipperLib::IntRect rect = {0, 0, 0, 0};
+    bool first = true;
+    for (const ClipperLib::Path& path : paths) {
+        for (const ClipperLib::IntPoint& p : path) {
+            if (first || (p.X < rect.left))     rect.left = p.X;
+            if (first || (p.X > rect.right))    rect.right = p.X;
+            if (first || (p.Y < rect.top))      rect.top = p.Y;
+            if (first || (p.Y > rect.bottom))   rect.bottom = p.Y;
+            first = false;
+        }
+    }
+    return rect;
+}
+
+bool ClipperHelpers::intersects(const ClipperLib::IntRect& a,
+                                const ClipperLib::IntRect& b) noexcept
+{
+    return (a.left <= b.right) && (b.left <= a.right) &&
+           (a.top <= b.bottom) && (b.top <= a.bottom);
+}
+
 ClipperLib::Paths ClipperHelpers::flattenTree(const ClipperLib::PolyNode& node)
 {
     ClipperLib::Paths paths;
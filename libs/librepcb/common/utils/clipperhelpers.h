@@ -54,6 +54,25 @@ class ClipperHelpers final
                            const Length& maxArcTolerance);
         static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
 
+        /**
+         * @brief Get the axis-aligned bounding rect of some paths
+         *
+         * @param paths     The paths (if empty, a rect with all values zero is returned)
+         *
+         * @return The bounding rect
+         */
+        static ClipperLib::IntRect getBoundingRect(const ClipperLib::Paths& paths) noexcept;
+
+        /**
+         * @brief Check whether two bounding rects intersect (or touch)
+         *
+         * This is a cheap test to filter out paths before passing them to a
+         * ClipperLib::Clipper, since paths whose bounding rects do not intersect can't
+         * affect each other.
+         */
+        static bool intersects(const ClipperLib::IntRect& a,
+                               const ClipperLib::IntRect& b) noexcept;
+
         // Type Conversions
         static QVector<Path> convert(const ClipperLib::Paths& paths) noexcept;
         static Path convert(const ClipperLib::Path& path) noexcept;
@@ -28,20 +28,58 @@
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QString Uuid::toStr() const noexcept
+{
+    if (isNull()) return QString();
+
+    static const char hexDigits[] = "0123456789abcdef";
+    QString str(36, '-');
+    QChar* data = str.data();
+    int pos = 0;
+    for (int i = 0; i < 32; ++i) {
+        if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) ++pos; // '-'
+        quint64 word = (i < 16) ? mHigh : mLow;
+        int shift = 60 - ((i % 16) * 4);
+        data[pos++] = QLatin1Char(hexDigits[(word >> shift) & 0xF]);
+    }
+    return str;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
 
 bool Uuid::setUuid(const QString& uuid) noexcept
 {
-    mUuid = QString(); // make UUID invalid
-    QString lowercaseUuid = uuid.toLower();
-    if (lowercaseUuid.length() != 36)       return false; // do NOT accept '{' and '}'
-    QUuid quuid(lowercaseUuid);
-    if (quuid.isNull())                     return false;
-    if (quuid.variant() != QUuid::DCE)      return false;
-    if (quuid.version() != QUuid::Random)   return false;
-    mUuid = lowercaseUuid;
+    mHigh = mLow = 0; // make UUID invalid
+    if (uuid.length() != 36) return false; // do NOT accept '{' and '}'
+
+    quint64 words[2] = {0, 0};
+    int nibble = 0;
+    const QChar* data = uuid.constData();
+    for (int i = 0; i < 36; ++i) {
+        ushort c = data[i].unicode();
+        if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+            if (c != '-') return false;
+            continue;
+        }
+        quint64 value;
+        if ((c >= '0') && (c <= '9'))       value = c - '0';
+        else if ((c >= 'a') && (c <= 'f'))  value = c - 'a' + 10;
+        else if ((c >= 'A') && (c <= 'F'))  value = c - 'A' + 10;
+        else                                return false;
+        quint64& word = words[nibble / 16];
+        word = (word << 4) | value;
+        ++nibble;
+    }
+    if (((words[0] >> 12) & 0xF) != 4)  return false; // version must be 4 (random)
+    if ((words[1] >> 62) != 2)          return false; // variant must be DCE (RFC4122)
+    mHigh = words[0];
+    mLow = words[1];
     return true;
 }
 
@@ -51,14 +89,15 @@ bool Uuid::setUuid(const QString& uuid) noexcept
 
 Uuid& Uuid::operator=(const Uuid& rhs) noexcept
 {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
     return *this;
 }
 
 bool Uuid::operator==(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid == rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
 }
 
 bool Uuid::operator!=(const Uuid& rhs) const noexcept
@@ -68,26 +107,25 @@ bool Uuid::operator!=(const Uuid& rhs) const noexcept
 
 bool Uuid::operator<(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid < rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
 }
 
 bool Uuid::operator>(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid > rhs.mUuid);
+    return rhs < *this;
 }
 
 bool Uuid::operator<=(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid <= rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return !(rhs < *this);
 }
 
 bool Uuid::operator>=(const Uuid& rhs) const noexcept
 {
-    if (mUuid.isEmpty() || rhs.mUuid.isEmpty()) return false;
-    return (mUuid >= rhs.mUuid);
+    if (isNull() || rhs.isNull()) return false;
+    return !(*this < rhs);
 }
 
 /*****************************************************************************************
@@ -96,9 +134,17 @@ bool Uuid::operator>=(const Uuid& rhs) const noexcept
 
 Uuid Uuid::createRandom() noexcept
 {
-    Uuid uuid(QUuid::createUuid().toString().remove("{").remove("}"));
-    if (uuid.isNull()) {
+    QUuid quuid = QUuid::createUuid();
+    Uuid uuid;
+    uuid.mHigh = (static_cast<quint64>(quuid.data1) << 32) |
+                 (static_cast<quint64>(quuid.data2) << 16) |
+                 static_cast<quint64>(quuid.data3);
+    for (int i = 0; i < 8; ++i) {
+        uuid.mLow = (uuid.mLow << 8) | static_cast<quint64>(quuid.data4[i]);
+    }
+    if ((quuid.variant() != QUuid::DCE) || (quuid.version() != QUuid::Random)) {
         qCritical() << "Could not generate a valid random UUID!";
+        return Uuid();
     }
     return uuid;
 }
@@ -61,21 +61,21 @@ class Uuid final
         /**
          * @brief Default constructor (creates a NULL #Uuid object)
          */
-        Uuid() noexcept : mUuid() {}
+        Uuid() noexcept : mHigh(0), mLow(0) {}
 
         /**
          * @brief Constructor which creates a #Uuid object from a string
          *
          * @param uuid      The uuid as a string (without braces)
          */
-        explicit Uuid(const QString& uuid) noexcept : mUuid() {setUuid(uuid);}
+        explicit Uuid(const QString& uuid) noexcept : mHigh(0), mLow(0) {setUuid(uuid);}
 
         /**
          * @brief Copy constructor
          *
          * @param other     Another #Uuid object
          */
-        Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+        Uuid(const Uuid& other) noexcept : mHigh(other.mHigh), mLow(other.mLow) {}
 
         /**
          * @brief Destructor
@@ -90,14 +90,17 @@ class Uuid final
          *
          * @return true if NULL/invalid UUID, false if valid UUID
          */
-        bool isNull() const noexcept {return mUuid.isEmpty();}
+        bool isNull() const noexcept {return (mHigh == 0) && (mLow == 0);}
 
         /**
          * @brief Get the UUID as a string (without braces)
          *
-         * @return The UUID as a string
+         * @note The string is created on every call, so avoid calling this in
+         *       performance critical code (e.g. use the UUID itself as a map key).
+         *
+         * @return The UUID as a string (lowercase), or a null string if #isNull()
          */
-        QString toStr() const noexcept {return mUuid;}
+        QString toStr() const noexcept;
 
         /**
          * @brief Serialize this object into a string
@@ -171,16 +174,28 @@ class Uuid final
     private:
 
         // Private Attributes
-        QString mUuid;
+
+        /**
+         * @brief The 128 bits of the UUID, most significant 64 bits first
+         *
+         * Both are zero for a NULL UUID (valid UUIDs are never zero because of the
+         * version bits). Since the string representation is fixed length lowercase hex,
+         * comparing these integers gives the same ordering as comparing the strings.
+         */
+        quint64 mHigh;
+        quint64 mLow;
+
+        friend uint qHash(const Uuid& key, uint seed) noexcept;
 };
 
 /*****************************************************************************************
  *  Non-Member Functions
  ****************************************************************************************/
 
-inline uint qHash(const Uuid& key, uint seed)
+inline uint qHash(const Uuid& key, uint seed) noexcept
 {
-    return qHash(key.toStr(), seed);
+    // the bits of random UUIDs are already uniformly distributed
+    return ::qHash(key.mHigh ^ key.mLow, seed);
 }
 
 inline QDataStream& operator<<(QDataStream& stream, const Uuid& uuid)
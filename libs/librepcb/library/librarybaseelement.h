@@ -44,6 +44,19 @@ namespace library {
 
 /**
  * @brief The LibraryBaseElement class
+ *
+ * Loading an element from its directory (the constructor with the directory parameter,
+ * also in all subclasses) is allowed in any thread. This is used to load many elements
+ * in parallel (see librepcb::workspace::WorkspaceLibraryScanner and
+ * librepcb::project::ProjectLibrary). Therefore, these constructors must only read
+ * their own files and build their own members. They must neither access global objects
+ * (except immutable ones like the application version) nor create any GUI objects
+ * (e.g. pixmaps or graphics items).
+ *
+ * Like every QObject, the loaded element belongs to the thread which created it and
+ * has no parent. If it is used in another thread, the loading thread must move it
+ * with QObject::moveToThread() before handing it over. All other methods are not
+ * thread-safe and must only be called in the thread the element belongs to.
  */
 class LibraryBaseElement : public QObject, public SerializableObject
 {
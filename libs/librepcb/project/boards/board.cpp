@@ -50,6 +50,7 @@
 #include "boardlayerstack.h"
 #include "boardusersettings.h"
 #include "boardselectionquery.h"
+#include "boardplanesrebuilder.h"
 #include "../circuit/netsignal.h"
 
 /*****************************************************************************************
@@ -69,6 +70,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mPlanesRebuilder.reset(new BoardPlanesRebuilder(*this));
 
         // copy the other board
         mFile.reset(SmartSExprFile::create(mFilePath));
@@ -132,6 +134,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        mPlanesRebuilder.reset(); // must not access the board items anymore
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mPlanes);            mPlanes.clear();
@@ -148,12 +151,14 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
 }
 
 Board::Board(Project& project, const FilePath& filepath, bool restore,
-             bool readOnly, bool create, const QString& newName) :
+             bool readOnly, bool create, const QString& newName,
+             std::unique_ptr<SmartSExprFile>&& file, const SExpression* root) :
     QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false)
 {
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mPlanesRebuilder.reset(new BoardPlanesRebuilder(*this));
 
         // try to open/create the board file
         if (create)
@@ -183,33 +188,34 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
         }
         else
         {
-            mFile.reset(new SmartSExprFile(mFilePath, restore, readOnly));
-            SExpression root = mFile->parseFileAndBuildDomTree();
+            Q_ASSERT(file && root);
+            Q_ASSERT(file->getFilepath() == mFilePath);
+            mFile.reset(file.release());
 
             // the board seems to be ready to open, so we will create all needed objects
 
-            if (root.getChildByIndex(0).isString()) {
-                mUuid = root.getChildByIndex(0).getValue<Uuid>(true);
+            if (root->getChildByIndex(0).isString()) {
+                mUuid = root->getChildByIndex(0).getValue<Uuid>(true);
             } else {
                 // backward compatibility, remove this some time!
-                mUuid = root.getValueByPath<Uuid>("uuid", true);
+                mUuid = root->getValueByPath<Uuid>("uuid", true);
             }
-            mName = root.getValueByPath<QString>("name", true);
+            mName = root->getValueByPath<QString>("name", true);
 
             // Load grid properties
-            mGridProperties.reset(new GridProperties(root.getChildByPath("grid")));
+            mGridProperties.reset(new GridProperties(root->getChildByPath("grid")));
 
             // Load layer stack
-            mLayerStack.reset(new BoardLayerStack(*this, root.getChildByPath("layers")));
+            mLayerStack.reset(new BoardLayerStack(*this, root->getChildByPath("layers")));
 
             // load design rules
-            mDesignRules.reset(new BoardDesignRules(root.getChildByPath("design_rules")));
+            mDesignRules.reset(new BoardDesignRules(root->getChildByPath("design_rules")));
 
             // load user settings
             mUserSettings.reset(new BoardUserSettings(*this, restore, readOnly, create));
 
             // Load all device instances
-            foreach (const SExpression& node, root.getChildren("device")) {
+            foreach (const SExpression& node, root->getChildren("device")) {
                 BI_Device* device = new BI_Device(*this, node);
                 if (getDeviceInstanceByComponentUuid(device->getComponentInstanceUuid())) {
                     throw RuntimeError(__FILE__, __LINE__,
@@ -220,7 +226,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
             }
 
             // Load all netsegments
-            foreach (const SExpression& node, root.getChildren("netsegment")) {
+            foreach (const SExpression& node, root->getChildren("netsegment")) {
                 BI_NetSegment* netsegment = new BI_NetSegment(*this, node);
                 if (getNetSegmentByUuid(netsegment->getUuid())) {
                     throw RuntimeError(__FILE__, __LINE__,
@@ -231,19 +237,19 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
             }
 
             // Load all planes
-            foreach (const SExpression& node, root.getChildren("plane")) {
+            foreach (const SExpression& node, root->getChildren("plane")) {
                 BI_Plane* plane = new BI_Plane(*this, node);
                 mPlanes.append(plane);
             }
 
             // Load all polygons
-            foreach (const SExpression& node, root.getChildren("polygon")) {
+            foreach (const SExpression& node, root->getChildren("polygon")) {
                 BI_Polygon* polygon = new BI_Polygon(*this, node);
                 mPolygons.append(polygon);
             }
         }
 
-        rebuildAllPlanes();
+        rebuildAllPlanesInBackground();
         updateErcMessages();
         updateIcon();
 
@@ -258,6 +264,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
     catch (...)
     {
         // free the allocated memory in the reverse order of their allocation...
+        mPlanesRebuilder.reset(); // must not access the board items anymore
         qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mPlanes);            mPlanes.clear();
@@ -279,6 +286,9 @@ Board::~Board() noexcept
 
     qDeleteAll(mErcMsgListUnplacedComponentInstances);    mErcMsgListUnplacedComponentInstances.clear();
 
+    // stop rebuilding planes before deleting them
+    mPlanesRebuilder.reset();
+
     // delete all items
     qDeleteAll(mPolygons);          mPolygons.clear();
     qDeleteAll(mPlanes);            mPlanes.clear();
@@ -320,7 +330,19 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
         list.append(netline);
     }
     // footprints & pads
-    foreach (BI_Device* device, mDeviceInstances) {
+    QList<BI_Device*> devices;
+    foreach (BI_Base* item, getItemsInSpatialIndex<BI_Base>(scenePosPx)) {
+        BI_Device* device = nullptr;
+        if (BI_Footprint* footprint = qobject_cast<BI_Footprint*>(item)) {
+            device = &footprint->getDeviceInstance();
+        } else if (BI_FootprintPad* pad = qobject_cast<BI_FootprintPad*>(item)) {
+            device = &pad->getFootprint().getDeviceInstance();
+        }
+        if (device && (!devices.contains(device))) {
+            devices.append(device);
+        }
+    }
+    foreach (BI_Device* device, devices) {
         BI_Footprint& footprint = device->getFootprint();
         if (footprint.isSelectable() && footprint.getGrabAreaScenePx().contains(scenePosPx)) {
             if (footprint.getIsMirrored()) {
@@ -340,13 +362,13 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
         }
     }
     // planes
-    foreach (BI_Plane* planes, mPlanes) {
-        if (planes->isSelectable() && planes->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(planes);
+    foreach (BI_Plane* plane, getItemsInSpatialIndex<BI_Plane>(scenePosPx)) {
+        if (plane->isSelectable() && plane->getGrabAreaScenePx().contains(scenePosPx)) {
+            list.append(plane);
         }
     }
     // polygons
-    foreach (BI_Polygon* polygon, mPolygons) {
+    foreach (BI_Polygon* polygon, getItemsInSpatialIndex<BI_Polygon>(scenePosPx)) {
         if (polygon->isSelectable() && polygon->getGrabAreaScenePx().contains(scenePosPx)) {
             list.append(polygon);
         }
@@ -356,10 +378,13 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 
 QList<BI_Via*> Board::getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_Via*> list;
-    foreach (BI_NetSegment* segment, mNetSegments) {
-        if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-            segment->getViasAtScenePos(pos, list);
+    foreach (BI_Via* via, getItemsInSpatialIndex<BI_Via>(scenePosPx)) {
+        if (via->isSelectable() && via->getGrabAreaScenePx().contains(scenePosPx)
+            && ((!netsignal) || (&via->getNetSegment().getNetSignal() == netsignal)))
+        {
+            list.append(via);
         }
     }
     return list;
@@ -368,10 +393,14 @@ QList<BI_Via*> Board::getViasAtScenePos(const Point& pos, const NetSignal* netsi
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                   const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_NetPoint*> list;
-    foreach (BI_NetSegment* segment, mNetSegments) {
-        if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-            segment->getNetPointsAtScenePos(pos, layer, list);
+    foreach (BI_NetPoint* netpoint, getItemsInSpatialIndex<BI_NetPoint>(scenePosPx)) {
+        if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(scenePosPx)
+            && ((!layer) || (&netpoint->getLayer() == layer))
+            && ((!netsignal) || (&netpoint->getNetSegment().getNetSignal() == netsignal)))
+        {
+            list.append(netpoint);
         }
     }
     return list;
@@ -380,10 +409,14 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(const Point& pos, const Graphi
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                 const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_NetLine*> list;
-    foreach (BI_NetSegment* segment, mNetSegments) {
-        if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-            segment->getNetLinesAtScenePos(pos, layer, list);
+    foreach (BI_NetLine* netline, getItemsInSpatialIndex<BI_NetLine>(scenePosPx)) {
+        if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(scenePosPx)
+            && ((!layer) || (&netline->getLayer() == layer))
+            && ((!netsignal) || (&netline->getNetSegment().getNetSignal() == netsignal)))
+        {
+            list.append(netline);
         }
     }
     return list;
@@ -392,17 +425,15 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(const Point& pos, const Graphics
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(const Point& pos, const GraphicsLayer* layer,
                                                  const NetSignal* netsignal) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<BI_FootprintPad*> list;
-    foreach (BI_Device* device, mDeviceInstances)
+    foreach (BI_FootprintPad* pad, getItemsInSpatialIndex<BI_FootprintPad>(scenePosPx))
     {
-        foreach (BI_FootprintPad* pad, device->getFootprint().getPads())
+        if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx)
+            && ((!layer) || (pad->isOnLayer(layer->getName())))
+            && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
         {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(pos.toPxQPointF())
-                && ((!layer) || (pad->isOnLayer(layer->getName())))
-                && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
-            {
-                list.append(pad);
-            }
+            list.append(pad);
         }
     }
     return list;
@@ -429,6 +460,7 @@ QList<BI_Base*> Board::getAllItems() const noexcept
 void Board::setGridProperties(const GridProperties& grid) noexcept
 {
     *mGridProperties = grid;
+    setModified();
 }
 
 /*****************************************************************************************
@@ -537,13 +569,13 @@ void Board::removePlane(BI_Plane& plane)
 
 void Board::rebuildAllPlanes() noexcept
 {
-    QList<BI_Plane*> planes = mPlanes;
-    qSort(planes.begin(), planes.end(),
-          [](const BI_Plane* p1, const BI_Plane* p2)
-          {return !(*p1 < *p2);}); // sort by priority (highest priority first)
-    foreach (BI_Plane* plane, planes) {
-        plane->rebuild();
-    }
+    mPlanesRebuilder->startRebuild(mPlanes);
+    mPlanesRebuilder->waitForFinished();
+}
+
+void Board::rebuildAllPlanesInBackground() noexcept
+{
+    mPlanesRebuilder->startRebuild(mPlanes);
 }
 
 /*****************************************************************************************
@@ -617,8 +649,10 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
     {
         if (mIsAddedToProject)
         {
-            SExpression doc(serializeToDomElement("librepcb_board"));
-            mFile->save(doc, toOriginal);
+            if (mFile->isModified(toOriginal)) {
+                SExpression doc(serializeToDomElement("librepcb_board"));
+                mFile->save(doc, toOriginal);
+            }
         }
         else
         {
@@ -639,6 +673,34 @@ bool Board::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Board::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                  QStringList& errors) noexcept
+{
+    bool success = true;
+
+    // capture board file
+    try {
+        if (mIsAddedToProject) {
+            if (mFile->isModified(false)) {
+                SExpression doc(serializeToDomElement("librepcb_board"));
+                snapshots.append(mFile->createSnapshot(doc)); // can throw
+            }
+        } else {
+            mFile->removeFile(false); // can throw
+        }
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    // capture user settings
+    if (!mUserSettings->createBackupSnapshots(snapshots, errors)) {
+        success = false;
+    }
+
+    return success;
+}
+
 void Board::showInView(GraphicsView& view) noexcept
 {
     view.setScene(mGraphicsScene.data());
@@ -649,25 +711,31 @@ void Board::setSelectionRect(const Point& p1, const Point& p2, bool updateItems)
     mGraphicsScene->setSelectionRect(p1, p2);
     if (updateItems) {
         QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+        // only items found in the spatial index need to be checked exactly
+        QSet<const BI_Base*> candidates;
+        foreach (const BI_Base* item, getItemsInSpatialIndex<BI_Base>(rectPx)) {
+            candidates.insert(item);
+        }
+        auto isInRect = [&](const BI_Base& item) {
+            return candidates.contains(&item) && item.isSelectable()
+                && item.getGrabAreaScenePx().intersects(rectPx);
+        };
         foreach (BI_Device* component, mDeviceInstances) {
             BI_Footprint& footprint = component->getFootprint();
-            bool selectFootprint = footprint.isSelectable() && footprint.getGrabAreaScenePx().intersects(rectPx);
+            bool selectFootprint = isInRect(footprint);
             footprint.setSelected(selectFootprint);
             foreach (BI_FootprintPad* pad, footprint.getPads()) {
-                bool selectPad = pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-                pad->setSelected(selectFootprint || selectPad);
+                pad->setSelected(selectFootprint || isInRect(*pad));
             }
         }
         foreach (BI_NetSegment* segment, mNetSegments) {
-            segment->setSelectionRect(rectPx);
+            segment->setSelectionRect(rectPx, candidates);
         }
         foreach (BI_Plane* plane, mPlanes) {
-            bool select = plane->isSelectable() && plane->getGrabAreaScenePx().intersects(rectPx);
-            plane->setSelected(select);
+            plane->setSelected(isInRect(*plane));
         }
         foreach (BI_Polygon* polygon, mPolygons) {
-            bool select = polygon->isSelectable() && polygon->getGrabAreaScenePx().intersects(rectPx);
-            polygon->setSelected(select);
+            polygon->setSelected(isInRect(*polygon));
         }
     }
 }
@@ -716,6 +784,19 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const noe
  *  Private Methods
  ****************************************************************************************/
 
+template <typename T, typename Area>
+QList<T*> Board::getItemsInSpatialIndex(const Area& areaPx) const noexcept
+{
+    QList<T*> items;
+    foreach (const QGraphicsItem* graphicsItem, mGraphicsScene->items(areaPx,
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder)) {
+        if (T* item = qobject_cast<T*>(BI_Base::fromGraphicsItem(*graphicsItem))) {
+            items.append(item);
+        }
+    }
+    return items;
+}
+
 void Board::updateIcon() noexcept
 {
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
@@ -797,7 +878,7 @@ void Board::updateErcMessages() noexcept
 
 Board* Board::create(Project& project, const FilePath& filepath, const QString& name)
 {
-    return new Board(project, filepath, false, false, true, name);
+    return new Board(project, filepath, false, false, true, name, nullptr, nullptr);
 }
 
 /*****************************************************************************************
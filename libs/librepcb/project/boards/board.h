@@ -30,6 +30,7 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/uuid.h>
 #include "../erc/if_ercmsgprovider.h"
@@ -42,7 +43,6 @@ namespace librepcb {
 class GridProperties;
 class GraphicsView;
 class GraphicsScene;
-class SmartSExprFile;
 class GraphicsLayer;
 class BoardDesignRules;
 
@@ -62,6 +62,7 @@ class BI_Plane;
 class BoardLayerStack;
 class BoardUserSettings;
 class BoardSelectionQuery;
+class BoardPlanesRebuilder;
 
 /*****************************************************************************************
  *  Class Board
@@ -104,8 +105,21 @@ class Board final : public QObject, public AttributeProvider,
         Board() = delete;
         Board(const Board& other) = delete;
         Board(const Board& other, const FilePath& filepath, const QString& name);
-        Board(Project& project, const FilePath& filepath, bool restore, bool readOnly) :
-            Board(project, filepath, restore, readOnly, false, QString()) {}
+
+        /**
+         * @brief Load an existing board
+         *
+         * @param project   The project of the board
+         * @param file      The opened board file (the board takes the ownership)
+         * @param root      The already parsed content of the file (allows to open and
+         *                  parse the files of several boards concurrently)
+         *
+         * @throw Exception If the board could not be loaded
+         */
+        Board(Project& project, std::unique_ptr<SmartSExprFile> file,
+              const SExpression& root) :
+            Board(project, file->getFilepath(), file->isRestored(), file->isReadOnly(),
+                  false, QString(), std::move(file), &root) {}
         ~Board() noexcept;
 
         // Getters: General
@@ -152,6 +166,8 @@ class Board final : public QObject, public AttributeProvider,
         void addPlane(BI_Plane& plane);
         void removePlane(BI_Plane& plane);
         void rebuildAllPlanes() noexcept;
+        void rebuildAllPlanesInBackground() noexcept;
+        BoardPlanesRebuilder& getPlanesRebuilder() const noexcept {return *mPlanesRebuilder;}
 
         // Polygon Methods
         const QList<BI_Polygon*>& getPolygons() const noexcept {return mPolygons;}
@@ -161,7 +177,11 @@ class Board final : public QObject, public AttributeProvider,
         // General Methods
         void addToProject();
         void removeFromProject();
+        bool isModified(bool original) const noexcept {return mFile->isModified(original);}
+        void setModified() noexcept {mFile->setModified();}
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
         void showInView(GraphicsView& view) noexcept;
         void saveViewSceneRect(const QRectF& rect) noexcept {mViewRect = rect;}
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
@@ -197,11 +217,28 @@ class Board final : public QObject, public AttributeProvider,
     private:
 
         Board(Project& project, const FilePath& filepath, bool restore,
-              bool readOnly, bool create, const QString& newName);
+              bool readOnly, bool create, const QString& newName,
+              std::unique_ptr<SmartSExprFile>&& file, const SExpression* root);
         void updateIcon() noexcept;
         bool checkAttributesValidity() const noexcept;
         void updateErcMessages() noexcept;
 
+        /**
+         * @brief Get all items of a specific type whose bounding rect touches an area
+         *
+         * The lookup uses the BSP tree index of the graphics scene (which is kept up to
+         * date by Qt when graphics items are moved or changed), so it's much faster than
+         * iterating over all items. The result still needs to be checked against the
+         * exact grab area of the items.
+         *
+         * @tparam T        Type of the board items to return
+         * @tparam Area     QPointF or QRectF (scene coordinates in pixels)
+         *
+         * @return The found items, the top most item first
+         */
+        template <typename T, typename Area>
+        QList<T*> getItemsInSpatialIndex(const Area& areaPx) const noexcept;
+
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
 
@@ -217,6 +254,7 @@ class Board final : public QObject, public AttributeProvider,
         QScopedPointer<GridProperties> mGridProperties;
         QScopedPointer<BoardDesignRules> mDesignRules;
         QScopedPointer<BoardUserSettings> mUserSettings;
+        QScopedPointer<BoardPlanesRebuilder> mPlanesRebuilder;
         QRectF mViewRect;
 
         // Attributes
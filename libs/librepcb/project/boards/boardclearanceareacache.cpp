@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardclearanceareacache.h"
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct BoardClearanceAreaCache::Area
+ ****************************************************************************************/
+
+BoardClearanceAreaCache::Area::Area(const ClipperLib::Paths& p) noexcept :
+    paths(p), bounds(ClipperHelpers::getBoundingRect(p))
+{
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardClearanceAreaCache::BoardClearanceAreaCache(const Length& maxArcTolerance) noexcept :
+    mMaxArcTolerance(maxArcTolerance)
+{
+}
+
+BoardClearanceAreaCache::~BoardClearanceAreaCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+std::shared_ptr<const BoardClearanceAreaCache::Area> BoardClearanceAreaCache::getArea(
+    const ItemKey& key, quint64 revision, const Length& clearance,
+    const std::function<Path()>& outline) noexcept
+{
+    Entry& entry = mEntries[qMakePair(key, clearance.toNm())];
+    if ((!entry.area) || (entry.revision != revision)) {
+        ClipperLib::Paths paths;
+        Path path = outline();
+        if (!path.getVertices().isEmpty()) {
+            paths.push_back(ClipperHelpers::convert(path, mMaxArcTolerance));
+        }
+        entry.revision = revision;
+        entry.area = std::make_shared<Area>(paths);
+    }
+    entry.used = true;
+    return entry.area;
+}
+
+void BoardClearanceAreaCache::removeUnusedAreas() noexcept
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        if (it.value().used) {
+            it.value().used = false;
+            ++it;
+        } else {
+            it = mEntries.erase(it);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDCLEARANCEAREACACHE_H
+#define LIBREPCB_PROJECT_BOARDCLEARANCEAREACACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <functional>
+#include <QtCore>
+#include <clipper/clipper.hpp>
+#include <librepcb/common/units/length.h>
+#include <librepcb/common/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Path;
+
+namespace project {
+
+/*****************************************************************************************
+ *  Class BoardClearanceAreaCache
+ ****************************************************************************************/
+
+/**
+ * @brief Caches the flattened outlines of board items, expanded by some clearance
+ *
+ * Building plane fragments requires the outlines of pads, vias, traces and holes as
+ * ClipperLib paths, expanded by the clearance of the plane. This cache keeps them as
+ * long as the geometry revision of the item (see
+ * librepcb::project::BI_Base::getGeometryRevision()) does not change, so they are
+ * neither recreated for every plane nor for every rebuild.
+ *
+ * The cache is not thread-safe, but the returned areas are immutable and can be shared
+ * between threads.
+ */
+class BoardClearanceAreaCache final
+{
+    public:
+
+        // Types
+
+        /// UUIDs of the owner of an item (e.g. the device of a pad) and the item itself
+        typedef QPair<Uuid, Uuid> ItemKey;
+
+        /// An item's area, flattened and expanded by the clearance
+        struct Area {
+            explicit Area(const ClipperLib::Paths& p) noexcept;
+            ClipperLib::Paths paths;
+            ClipperLib::IntRect bounds;     ///< bounding rect of #paths
+        };
+
+        // Constructors / Destructor
+        BoardClearanceAreaCache() = delete;
+        BoardClearanceAreaCache(const BoardClearanceAreaCache& other) = delete;
+        explicit BoardClearanceAreaCache(const Length& maxArcTolerance) noexcept;
+        ~BoardClearanceAreaCache() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Get the area of an item
+         *
+         * @param key           Identifies the item
+         * @param revision      The geometry revision of the item
+         * @param clearance     The clearance the outline is expanded by
+         * @param outline       Creates the item's outline (already expanded by the
+         *                      clearance), only called if it is not cached yet
+         *
+         * @return The cached or newly created area
+         */
+        std::shared_ptr<const Area> getArea(const ItemKey& key, quint64 revision,
+                                            const Length& clearance,
+                                            const std::function<Path()>& outline) noexcept;
+
+        /**
+         * @brief Remove all areas which were not requested since the last call
+         *
+         * This releases the areas of removed items and of unused clearance values.
+         */
+        void removeUnusedAreas() noexcept;
+
+        // Operator Overloadings
+        BoardClearanceAreaCache& operator=(const BoardClearanceAreaCache& rhs) = delete;
+
+
+    private: // Types
+        struct Entry {
+            quint64 revision;
+            std::shared_ptr<const Area> area;
+            bool used;
+        };
+
+
+    private: // Data
+        Length mMaxArcTolerance;
+        QHash<QPair<ItemKey, LengthBase_t>, Entry> mEntries;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDCLEARANCEAREACACHE_H
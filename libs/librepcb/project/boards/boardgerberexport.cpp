@@ -20,6 +20,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include "boardgerberexport.h"
 #include <librepcb/common/cam/gerbergenerator.h>
@@ -48,12 +49,82 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Struct BoardGerberExport::JobResult
+ ****************************************************************************************/
+
+/**
+ * @brief The result of one layer job, set by the export function in the worker thread
+ */
+struct BoardGerberExport::JobResult final
+{
+    FilePath filepath;
+    Length drillTravelDistance = Length(0); ///< only set by the drills job
+    std::shared_ptr<Exception> error;       ///< nullptr on success
+};
+
+/*****************************************************************************************
+ *  Struct BoardGerberExport::ExportState
+ ****************************************************************************************/
+
+/**
+ * @brief The results of all layer jobs, shared between the jobs and the calling thread
+ *
+ * All members must only be accessed with #mutex locked.
+ */
+struct BoardGerberExport::ExportState final
+{
+    QMutex mutex;
+    QWaitCondition jobFinished;
+    QVector<JobResult> results; ///< same order as the export functions
+    QList<int> finishedJobs;    ///< indices of finished but not yet reported results
+};
+
+/*****************************************************************************************
+ *  Class BoardGerberExport::LayerJob
+ ****************************************************************************************/
+
+/**
+ * @brief Generates and writes one layer (or the drills) in the thread pool
+ *
+ * Each job uses its own generator and only reads from the board.
+ */
+class BoardGerberExport::LayerJob final : public QRunnable
+{
+    public:
+        LayerJob(const BoardGerberExport& exp, ExportFunction function,
+                 ExportState& state, int index) noexcept :
+            QRunnable(), mExport(exp), mFunction(function), mState(state), mIndex(index) {}
+
+        void run() noexcept override {
+            JobResult result;
+            try {
+                (mExport.*mFunction)(result); // can throw
+            } catch (const Exception& e) {
+                result.error.reset(e.clone());
+            } catch (...) {
+                result.error = std::make_shared<LogicError>(__FILE__, __LINE__);
+            }
+            QMutexLocker locker(&mState.mutex);
+            mState.results[mIndex] = result;
+            mState.finishedJobs.append(mIndex);
+            mState.jobFinished.wakeAll();
+        }
+
+    private:
+        const BoardGerberExport& mExport;
+        ExportFunction mFunction;
+        ExportState& mState;
+        int mIndex;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 BoardGerberExport::BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept :
-    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir)
+    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir),
+    mDrillRouteOptimization(true), mDrillTravelDistance(0)
 {
 }
 
@@ -65,23 +136,63 @@ BoardGerberExport::~BoardGerberExport() noexcept
  *  General Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportAllLayers() const
+void BoardGerberExport::exportAllLayers()
 {
-    exportDrillsPTH();
-    exportLayerBoardOutlines();
-    exportLayerTopCopper();
-    exportLayerTopSolderMask();
-    exportLayerTopSilkscreen();
-    exportLayerBottomCopper();
-    exportLayerBottomSolderMask();
-    exportLayerBottomSilkscreen();
+    const QVector<ExportFunction> functions = {
+        &BoardGerberExport::exportDrillsPTH,
+        &BoardGerberExport::exportLayerBoardOutlines,
+        &BoardGerberExport::exportLayerTopCopper,
+        &BoardGerberExport::exportLayerTopSolderMask,
+        &BoardGerberExport::exportLayerTopSilkscreen,
+        &BoardGerberExport::exportLayerBottomCopper,
+        &BoardGerberExport::exportLayerBottomSolderMask,
+        &BoardGerberExport::exportLayerBottomSilkscreen,
+    };
+
+    // the thread pool must be destroyed before the state since the jobs access it
+    ExportState state;
+    state.results.resize(functions.count());
+    QThreadPool threadPool;
+    for (int i = 0; i < functions.count(); ++i) {
+        threadPool.start(new LayerJob(*this, functions.at(i), state, i));
+    }
+
+    // report the progress in the calling thread while the jobs are running
+    QMutexLocker locker(&state.mutex);
+    for (int exported = 1; exported <= functions.count(); ++exported) {
+        while (state.finishedJobs.isEmpty()) {
+            state.jobFinished.wait(&state.mutex);
+        }
+        const JobResult& result = state.results.at(state.finishedJobs.takeFirst());
+        if (!result.error) {
+            FilePath filepath = result.filepath;
+            locker.unlock();
+            emit layerExported(filepath, exported, functions.count());
+            locker.relock();
+        }
+    }
+    locker.unlock();
+    threadPool.waitForDone();
+
+    // the jobs are finished now, so their results can be taken over
+    mDrillTravelDistance = Length(0);
+    foreach (const JobResult& result, state.results) {
+        mDrillTravelDistance += result.drillTravelDistance;
+    }
+
+    // report the first error (in the order of the layers, not of their completion)
+    foreach (const JobResult& result, state.results) {
+        if (result.error) {
+            result.error->raise();
+        }
+    }
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-void BoardGerberExport::exportDrillsPTH() const
+void BoardGerberExport::exportDrillsPTH(JobResult& result) const
 {
     ExcellonGenerator gen;
 
@@ -106,38 +217,41 @@ void BoardGerberExport::exportDrillsPTH() const
         }
     }
 
+    gen.setRouteOptimization(mDrillRouteOptimization);
     gen.generate();
-    gen.saveToFile(getOutputFilePath("DRILLS-PTH.drl"));
+    result.drillTravelDistance = gen.getTravelDistance();
+    result.filepath = getOutputFilePath("DRILLS-PTH.drl");
+    gen.saveToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerBoardOutlines() const
+void BoardGerberExport::exportLayerBoardOutlines(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
     drawLayer(gen, GraphicsLayer::sBoardOutlines);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("OUTLINES.gbr"));
+    result.filepath = getOutputFilePath("OUTLINES.gbr");
+    gen.generateToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerTopCopper() const
+void BoardGerberExport::exportLayerTopCopper(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
     drawLayer(gen, GraphicsLayer::sTopCopper);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("COPPER-TOP.gbr"));
+    result.filepath = getOutputFilePath("COPPER-TOP.gbr");
+    gen.generateToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerTopSolderMask() const
+void BoardGerberExport::exportLayerTopSolderMask(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
     drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SOLDERMASK-TOP.gbr"));
+    result.filepath = getOutputFilePath("SOLDERMASK-TOP.gbr");
+    gen.generateToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerTopSilkscreen() const
+void BoardGerberExport::exportLayerTopSilkscreen(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
@@ -145,29 +259,29 @@ void BoardGerberExport::exportLayerTopSilkscreen() const
     drawLayer(gen, GraphicsLayer::sTopNames);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SILKSCREEN-TOP.gbr"));
+    result.filepath = getOutputFilePath("SILKSCREEN-TOP.gbr");
+    gen.generateToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerBottomCopper() const
+void BoardGerberExport::exportLayerBottomCopper(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
     drawLayer(gen, GraphicsLayer::sBotCopper);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("COPPER-BOTTOM.gbr"));
+    result.filepath = getOutputFilePath("COPPER-BOTTOM.gbr");
+    gen.generateToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask() const
+void BoardGerberExport::exportLayerBottomSolderMask(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
     drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SOLDERMASK-BOTTOM.gbr"));
+    result.filepath = getOutputFilePath("SOLDERMASK-BOTTOM.gbr");
+    gen.generateToFile(result.filepath);
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen() const
+void BoardGerberExport::exportLayerBottomSilkscreen(JobResult& result) const
 {
     GerberGenerator gen(mProject.getMetadata().getName() % " - " % mBoard.getName(),
                         mBoard.getUuid(), mProject.getMetadata().getVersion());
@@ -175,8 +289,8 @@ void BoardGerberExport::exportLayerBottomSilkscreen() const
     drawLayer(gen, GraphicsLayer::sBotNames);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(getOutputFilePath("SILKSCREEN-BOTTOM.gbr"));
+    result.filepath = getOutputFilePath("SILKSCREEN-BOTTOM.gbr");
+    gen.generateToFile(result.filepath);
 }
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen, const QString& layerName) const
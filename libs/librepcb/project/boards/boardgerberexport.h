@@ -52,6 +52,11 @@ class BI_FootprintPad;
 /**
  * @brief The BoardGerberExport class
  *
+ * All layers are independent of each other, so #exportAllLayers() generates and writes
+ * them concurrently, each with its own generator in a worker thread. The calling thread
+ * is blocked until all layers are exported, thus the board must not be modified
+ * meanwhile.
+ *
  * @author ubruhin
  * @date 2016-01-10
  */
@@ -67,24 +72,62 @@ class BoardGerberExport final : public QObject
         BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept;
         ~BoardGerberExport() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the travel distance of the drill head in the written drill file
+         *
+         * @return The travel distance of the last #exportAllLayers() call
+         */
+        const Length& getDrillTravelDistance() const noexcept {return mDrillTravelDistance;}
+
+        // Setters
+
+        /**
+         * @brief Enable or disable the optimization of the drill route (default: enabled)
+         *
+         * @param enabled   See ExcellonGenerator#setRouteOptimization()
+         */
+        void setDrillRouteOptimization(bool enabled) noexcept {
+            mDrillRouteOptimization = enabled;
+        }
+
         // General Methods
-        void exportAllLayers() const;
+        void exportAllLayers();
 
         // Operator Overloadings
         BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
 
 
+    signals:
+
+        /**
+         * @brief Emitted (in the calling thread) each time a layer has been exported
+         *
+         * @param filepath          The file which was written
+         * @param exportedLayers    Count of exported layers, including this one
+         * @param totalLayers       Count of layers to export
+         */
+        void layerExported(const FilePath& filepath, int exportedLayers, int totalLayers);
+
+
     private:
 
+        // Types
+        struct JobResult;
+        typedef void (BoardGerberExport::*ExportFunction)(JobResult& result) const;
+        struct ExportState;
+        class LayerJob;
+
         // Private Methods
-        void exportDrillsPTH() const;
-        void exportLayerBoardOutlines() const;
-        void exportLayerTopCopper() const;
-        void exportLayerTopSolderMask() const;
-        void exportLayerTopSilkscreen() const;
-        void exportLayerBottomCopper() const;
-        void exportLayerBottomSolderMask() const;
-        void exportLayerBottomSilkscreen() const;
+        void exportDrillsPTH(JobResult& result) const;
+        void exportLayerBoardOutlines(JobResult& result) const;
+        void exportLayerTopCopper(JobResult& result) const;
+        void exportLayerTopSolderMask(JobResult& result) const;
+        void exportLayerTopSilkscreen(JobResult& result) const;
+        void exportLayerBottomCopper(JobResult& result) const;
+        void exportLayerBottomSolderMask(JobResult& result) const;
+        void exportLayerBottomSilkscreen(JobResult& result) const;
 
         void drawLayer(GerberGenerator& gen, const QString& layerName) const;
         void drawVia(GerberGenerator& gen, const BI_Via& via, const QString& layerName) const;
@@ -101,6 +144,8 @@ class BoardGerberExport final : public QObject
         const Project& mProject;
         const Board& mBoard;
         FilePath mOutputDirectory;
+        bool mDrillRouteOptimization;
+        Length mDrillTravelDistance; ///< taken over from the drills job when it is finished
 };
 
 /*****************************************************************************************
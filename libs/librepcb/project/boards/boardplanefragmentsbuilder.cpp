@@ -26,6 +26,7 @@
 #include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
+#include "board.h"
 #include "items/bi_plane.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
@@ -42,19 +43,54 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Struct BoardPlaneFragmentsBuilder::Cache
+ ****************************************************************************************/
+
+/**
+ * @brief Results of a build which can be reused by the next build of the same plane
+ */
+struct BoardPlaneFragmentsBuilder::Cache final
+{
+    // inputs which affect all tiles (if one of them changes, everything is rebuilt)
+    Path outline;
+    Length minWidth;
+    Length minClearance;
+    QVector<Path> boardOutlines;
+
+    QMap<Uuid, QVector<Path>> otherPlaneFragments;
+    QMap<ItemKey, std::shared_ptr<const Area>> cutOuts; ///< including other planes
+    QVector<ClipperLib::Paths> tiles;   ///< area of each tile, row by row
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept :
-    mPlane(plane)
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(const BI_Plane& plane,
+    BoardClearanceAreaCache& areaCache) noexcept :
+    mOutline(plane.getOutline()), mMinWidth(plane.getMinWidth()),
+    mMinClearance(plane.getMinClearance()), mKeepOrphans(plane.getKeepOrphans()),
+    mBoundingRectPrefilter(true), mTileGrid{0, 0, 0, 0}
 {
+    takeSnapshot(plane, areaCache);
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BoardPlaneFragmentsBuilder::setDependencyFragments(const Uuid& plane,
+    const QVector<Path>& fragments) noexcept
+{
+    Q_ASSERT(mOtherPlaneFragments.contains(plane));
+    mOtherPlaneFragments.insert(plane, fragments);
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -62,30 +98,184 @@ BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept
 QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept
 {
     try {
-        mResult.clear();
+        mNewCache = std::make_shared<Cache>();
+        mNewCache->outline = mOutline;
+        mNewCache->minWidth = mMinWidth;
+        mNewCache->minClearance = mMinClearance;
+        mNewCache->boardOutlines = mBoardOutlines;
+
+        QVector<ClipperLib::IntRect> modifiedAreas;
+        prepareCutOuts(modifiedAreas); // can throw
         addPlaneOutline();
         clipToBoardOutline();
-        subtractOtherObjects();
-        ensureMinimumWidth();
+        buildTiles(canReuseTiles() ? &modifiedAreas : nullptr);
+        stitchTiles();
         flattenResult();
-        if (!mPlane.getKeepOrphans()) {
+        if (!mKeepOrphans) {
+            mConnectedNetSignalAreas.clear();
+            foreach (const std::shared_ptr<const Area>& area, mConnectedAreas) {
+                mConnectedNetSignalAreas.insert(mConnectedNetSignalAreas.end(),
+                                                area->paths.begin(), area->paths.end());
+            }
             removeOrphans();
         }
+        mOldCache.reset(); // not needed anymore
         return ClipperHelpers::convert(mResult);
     } catch (const Exception& e) {
+        mNewCache.reset();
         qCritical() << "Failed to build plane fragments! Leave plane empty...";
         qCritical() << "Inner error message:" << e.getMsg();
         return QVector<Path>();
     }
 }
 
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+bool BoardPlaneFragmentsBuilder::dependsOn(const BI_Plane& plane,
+                                           const BI_Plane& other) noexcept
+{
+    if (&other == &plane) return false;
+    if (other < plane) return false; // ignore planes with lower priority
+    if (other.getLayerName() != plane.getLayerName()) return false;
+    if (&other.getNetSignal() == &plane.getNetSignal()) return false;
+    return ClipperHelpers::intersects(getBoundingRect(plane.getOutline(), Length(0)),
+                      getBoundingRect(other.getOutline(), plane.getMinClearance()));
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+void BoardPlaneFragmentsBuilder::takeSnapshot(const BI_Plane& plane,
+    BoardClearanceAreaCache& areaCache) noexcept
+{
+    const Board& board = plane.getBoard();
+    const Length clearance = mMinClearance;
+
+    // board outlines
+    foreach (const BI_Polygon* polygon, board.getPolygons()) {
+        if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+            mBoardOutlines.append(polygon->getPolygon().getPath());
+        }
+    }
+
+    // other planes (only those with higher priority, see dependsOn())
+    foreach (const BI_Plane* other, board.getPlanes()) {
+        if (dependsOn(plane, *other)) {
+            mOtherPlaneFragments.insert(other->getUuid(), other->getFragments());
+        }
+    }
+
+    // holes and pads from devices
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+        const BI_Footprint& footprint = device->getFootprint();
+        const Uuid& deviceUuid = device->getComponentInstanceUuid();
+        for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
+            ItemKey key(deviceUuid, hole.getUuid());
+            mCutOuts.insert(key, areaCache.getArea(key, footprint.getGeometryRevision(),
+                clearance, [&]() {
+                    Point pos = footprint.mapToScene(hole.getPosition());
+                    Length dia = hole.getDiameter() + clearance * 2;
+                    return Path::circle(dia).translated(pos);
+                }));
+        }
+        foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+            if (!pad->isOnLayer(plane.getLayerName())) continue;
+            ItemKey key(deviceUuid, pad->getLibPadUuid());
+            if (pad->getCompSigInstNetSignal() == &plane.getNetSignal()) {
+                mConnectedAreas.append(areaCache.getArea(key, pad->getGeometryRevision(),
+                    Length(0), [&]() {return pad->getSceneOutline();}));
+            }
+            if (needsCutOut(plane, pad->getCompSigInstNetSignal())) {
+                mCutOuts.insert(key, areaCache.getArea(key, pad->getGeometryRevision(),
+                    clearance, [&]() {return pad->getSceneOutline(clearance);}));
+            }
+        }
+    }
+
+    // net segment items
+    foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+
+        // vias
+        foreach (const BI_Via* via, netsegment->getVias()) {
+            ItemKey key(netsegment->getUuid(), via->getUuid());
+            if (&netsegment->getNetSignal() == &plane.getNetSignal()) {
+                mConnectedAreas.append(areaCache.getArea(key, via->getGeometryRevision(),
+                    Length(0), [&]() {return via->getSceneOutline();}));
+            }
+            if (needsCutOut(plane, &netsegment->getNetSignal())) {
+                mCutOuts.insert(key, areaCache.getArea(key, via->getGeometryRevision(),
+                    clearance, [&]() {return via->getSceneOutline(clearance);}));
+            }
+        }
+
+        // netlines
+        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+            if (netline->getLayer().getName() != plane.getLayerName()) continue;
+            ItemKey key(netsegment->getUuid(), netline->getUuid());
+            if (&netsegment->getNetSignal() == &plane.getNetSignal()) {
+                mConnectedAreas.append(areaCache.getArea(key, netline->getGeometryRevision(),
+                    Length(0), [&]() {return netline->getSceneOutline();}));
+            } else {
+                mCutOuts.insert(key, areaCache.getArea(key, netline->getGeometryRevision(),
+                    clearance, [&]() {return netline->getSceneOutline(clearance);}));
+            }
+        }
+    }
+}
+
+bool BoardPlaneFragmentsBuilder::canReuseTiles() const noexcept
+{
+    return mOldCache
+        && (mOldCache->outline == mOutline)
+        && (mOldCache->minWidth == mMinWidth)
+        && (mOldCache->minClearance == mMinClearance)
+        && (mOldCache->boardOutlines == mBoardOutlines);
+}
+
+void BoardPlaneFragmentsBuilder::prepareCutOuts(QVector<ClipperLib::IntRect>& modifiedAreas)
+{
+    mNewCache->otherPlaneFragments = mOtherPlaneFragments;
+    mNewCache->cutOuts = mCutOuts;
+
+    // the fragments of other planes are expanded by our clearance, so they can only be
+    // reused if neither the fragments nor the clearance have changed
+    const bool reuse = mOldCache && (mOldCache->minClearance == mMinClearance);
+    for (auto it = mOtherPlaneFragments.constBegin(); it != mOtherPlaneFragments.constEnd(); ++it) {
+        ItemKey key(it.key(), Uuid());
+        if (reuse && mOldCache->otherPlaneFragments.contains(it.key())
+            && (mOldCache->otherPlaneFragments.value(it.key()) == it.value())) {
+            mNewCache->cutOuts.insert(key, mOldCache->cutOuts.value(key));
+        } else {
+            ClipperLib::Paths paths = ClipperHelpers::convert(it.value(), maxArcTolerance());
+            ClipperHelpers::offset(paths, mMinClearance, maxArcTolerance()); // can throw
+            mNewCache->cutOuts.insert(key, std::make_shared<Area>(paths));
+        }
+    }
+
+    // areas of the cache are shared as long as the items are not modified, so comparing
+    // the pointers is enough to detect modified items
+    if (!mOldCache) return;
+    for (auto it = mNewCache->cutOuts.constBegin(); it != mNewCache->cutOuts.constEnd(); ++it) {
+        std::shared_ptr<const Area> old = mOldCache->cutOuts.value(it.key());
+        if (old != it.value()) {
+            if (old && (!old->paths.empty())) modifiedAreas.append(old->bounds);
+            if (!it.value()->paths.empty()) modifiedAreas.append(it.value()->bounds);
+        }
+    }
+    for (auto it = mOldCache->cutOuts.constBegin(); it != mOldCache->cutOuts.constEnd(); ++it) {
+        if ((!mNewCache->cutOuts.contains(it.key())) && (!it.value()->paths.empty())) {
+            modifiedAreas.append(it.value()->bounds);
+        }
+    }
+}
+
 void BoardPlaneFragmentsBuilder::addPlaneOutline()
 {
-    mResult.push_back(ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
+    mPlaneArea.clear();
+    mPlaneArea.push_back(ClipperHelpers::convert(mOutline, maxArcTolerance()));
 }
 
 void BoardPlaneFragmentsBuilder::clipToBoardOutline()
@@ -93,104 +283,148 @@ void BoardPlaneFragmentsBuilder::clipToBoardOutline()
     // determine board area
     ClipperLib::Paths boardArea;
     ClipperLib::Clipper boardAreaClipper;
-    foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
-        if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-            ClipperLib::Path path = ClipperHelpers::convert(polygon->getPolygon().getPath(),
-                                                            maxArcTolerance());
-            boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
-        }
+    foreach (const Path& outline, mBoardOutlines) {
+        ClipperLib::Path path = ClipperHelpers::convert(outline, maxArcTolerance());
+        boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
     }
     boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
                              ClipperLib::pftEvenOdd);
 
     // perform clearance offset
-    ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(), maxArcTolerance()); // can throw
+    ClipperHelpers::offset(boardArea, -mMinClearance, maxArcTolerance()); // can throw
 
     // if we have no board area, abort here
     if (boardArea.empty()) return;
 
-    // clip result to board area
+    // clip plane area to board area
     ClipperLib::Clipper clip;
-    clip.AddPaths(mResult, ClipperLib::ptSubject, true);
+    clip.AddPaths(mPlaneArea, ClipperLib::ptSubject, true);
     clip.AddPaths(boardArea, ClipperLib::ptClip, true);
-    clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
+    clip.Execute(ClipperLib::ctIntersection, mPlaneArea, ClipperLib::pftNonZero,
                  ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::subtractOtherObjects()
+void BoardPlaneFragmentsBuilder::buildTiles(const QVector<ClipperLib::IntRect>* modifiedAreas)
 {
-    ClipperLib::Clipper c;
-    c.AddPaths(mResult, ClipperLib::ptSubject, true);
+    // the tile grid only depends on the plane outline
+    ClipperLib::IntRect bounds = getBoundingRect(mOutline, Length(0));
+    ClipperLib::cInt size = tileSize().toNm();
+    mTileGrid.left = bounds.left;
+    mTileGrid.top = bounds.top;
+    mTileGrid.columns = static_cast<int>((bounds.right - bounds.left) / size) + 1;
+    mTileGrid.rows = static_cast<int>((bounds.bottom - bounds.top) / size) + 1;
+    int count = mTileGrid.columns * mTileGrid.rows;
 
-    // subtract other planes
-    foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
-        if (plane == &mPlane) continue;
-        if (*plane < mPlane) continue; // ignore planes with lower priority
-        if (plane->getLayerName() != mPlane.getLayerName()) continue;
-        if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
-        ClipperLib::Paths paths = ClipperHelpers::convert(plane->getFragments(),
-                                                          maxArcTolerance());
-        ClipperHelpers::offset(paths, mPlane.getMinClearance(), maxArcTolerance()); // can throw
-        c.AddPaths(paths, ClipperLib::ptClip, true);
-    }
-
-    // subtract holes and pads from devices
-    foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-        for (const Hole& hole : device->getFootprint().getLibFootprint().getHoles()) {
-            Point pos = device->getFootprint().mapToScene(hole.getPosition());
-            Length dia = hole.getDiameter() + mPlane.getMinClearance() * 2;
-            Path path = Path::circle(dia).translated(pos);
-            c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                      ClipperLib::ptClip, true);
-        }
-        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
-            if (!pad->isOnLayer(mPlane.getLayerName())) continue;
-            if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-                ClipperLib::Path path = ClipperHelpers::convert(pad->getSceneOutline(),
-                                                                maxArcTolerance());
-                mConnectedNetSignalAreas.push_back(path);
+    // determine the tiles to rebuild (all if there is no cache to reuse)
+    QVector<bool> rebuild(count, modifiedAreas == nullptr);
+    if (modifiedAreas) {
+        Q_ASSERT(mOldCache->tiles.count() == count);
+        mNewCache->tiles = mOldCache->tiles;
+        foreach (const ClipperLib::IntRect& area, *modifiedAreas) {
+            int firstColumn, lastColumn, firstRow, lastRow;
+            if (!getTileRange(area, firstColumn, lastColumn, firstRow, lastRow)) continue;
+            for (int row = firstRow; row <= lastRow; ++row) {
+                for (int column = firstColumn; column <= lastColumn; ++column) {
+                    rebuild[row * mTileGrid.columns + column] = true;
+                }
             }
-            c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
         }
+    } else {
+        mNewCache->tiles = QVector<ClipperLib::Paths>(count);
     }
 
-    // subtract net segment items
-    foreach (const BI_NetSegment* netsegment, mPlane.getBoard().getNetSegments()) {
+    // cut-outs and tiles outside the bounding rect of the plane area can't affect the
+    // plane, so they are skipped without passing them to Clipper at all
+    const bool planeAreaEmpty = mBoundingRectPrefilter && mPlaneArea.empty();
+    const ClipperLib::IntRect planeAreaBounds = ClipperHelpers::getBoundingRect(mPlaneArea);
+    auto isOutsidePlaneArea = [&](const ClipperLib::IntRect& rect) {
+        return planeAreaEmpty || (mBoundingRectPrefilter &&
+                                  (!ClipperHelpers::intersects(rect, planeAreaBounds)));
+    };
 
-        // subtract vias
-        foreach (const BI_Via* via, netsegment->getVias()) {
-            if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-                ClipperLib::Path path = ClipperHelpers::convert(via->getSceneOutline(),
-                                                                maxArcTolerance());
-                mConnectedNetSignalAreas.push_back(path);
+    // assign the cut-outs to the tiles they affect
+    QVector<QVector<const Area*>> tileCutOuts(count);
+    foreach (const std::shared_ptr<const Area>& cutOut, mNewCache->cutOuts) {
+        if (cutOut->paths.empty() || isOutsidePlaneArea(cutOut->bounds)) continue;
+        int firstColumn, lastColumn, firstRow, lastRow;
+        if (!getTileRange(cutOut->bounds, firstColumn, lastColumn, firstRow, lastRow)) continue;
+        for (int row = firstRow; row <= lastRow; ++row) {
+            for (int column = firstColumn; column <= lastColumn; ++column) {
+                int index = row * mTileGrid.columns + column;
+                if (rebuild.at(index)) {
+                    tileCutOuts[index].append(cutOut.get());
+                }
             }
-            c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
         }
+    }
 
-        // subtract netlines
-        foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-            if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-            if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-                ClipperLib::Path path = ClipperHelpers::convert(netline->getSceneOutline(),
-                                                                maxArcTolerance());
-                mConnectedNetSignalAreas.push_back(path);
+    // build the tiles
+    for (int row = 0; row < mTileGrid.rows; ++row) {
+        for (int column = 0; column < mTileGrid.columns; ++column) {
+            int index = row * mTileGrid.columns + column;
+            if (!rebuild.at(index)) continue;
+            ClipperLib::IntRect tile = getTileRect(column, row);
+            if (isOutsidePlaneArea(tile)) {
+                mNewCache->tiles[index].clear();
             } else {
-                ClipperLib::Path path = ClipperHelpers::convert(
-                    netline->getSceneOutline(mPlane.getMinClearance()), maxArcTolerance());
-                c.AddPath(path, ClipperLib::ptClip, true);
+                mNewCache->tiles[index] = buildTile(tile, tileCutOuts.at(index)); // can throw
             }
         }
     }
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::buildTile(const ClipperLib::IntRect& tile,
+    const QVector<const Area*>& cutOuts) const
+{
+    // the area within the tile depends on everything within the margin around it
+    ClipperLib::cInt margin = getTileMargin();
+    ClipperLib::IntRect area = {tile.left - margin, tile.top - margin,
+                                tile.right + margin, tile.bottom + margin};
+
+    // clip the plane area to the tile (including its margin)
+    ClipperLib::Paths result;
+    ClipperLib::Clipper areaClipper;
+    areaClipper.AddPaths(mPlaneArea, ClipperLib::ptSubject, true);
+    areaClipper.AddPath(rectToPath(area), ClipperLib::ptClip, true);
+    areaClipper.Execute(ClipperLib::ctIntersection, result, ClipperLib::pftNonZero,
+                        ClipperLib::pftNonZero);
+    if (result.empty()) return result;
 
-    c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
+    // subtract other objects (only those overlapping the clipped plane area)
+    ClipperLib::IntRect resultBounds = ClipperHelpers::getBoundingRect(result);
+    ClipperLib::Clipper c;
+    c.AddPaths(result, ClipperLib::ptSubject, true);
+    foreach (const Area* cutOut, cutOuts) {
+        if ((!mBoundingRectPrefilter) ||
+            ClipperHelpers::intersects(cutOut->bounds, resultBounds)) {
+            c.AddPaths(cutOut->paths, ClipperLib::ptClip, true);
+        }
+    }
+    c.Execute(ClipperLib::ctDifference, result, ClipperLib::pftEvenOdd,
               ClipperLib::pftNonZero);
+
+    // ensure minimum width
+    Length delta = mMinWidth / 2;
+    ClipperHelpers::offset(result, -delta, maxArcTolerance()); // can throw
+    ClipperHelpers::offset(result, delta, maxArcTolerance()); // can throw
+
+    // remove the margin again
+    ClipperLib::Clipper tileClipper;
+    tileClipper.AddPaths(result, ClipperLib::ptSubject, true);
+    tileClipper.AddPath(rectToPath(tile), ClipperLib::ptClip, true);
+    tileClipper.Execute(ClipperLib::ctIntersection, result, ClipperLib::pftNonZero,
+                        ClipperLib::pftNonZero);
+    return result;
 }
 
-void BoardPlaneFragmentsBuilder::ensureMinimumWidth()
+void BoardPlaneFragmentsBuilder::stitchTiles()
 {
-    Length delta = mPlane.getMinWidth() / 2;
-    ClipperHelpers::offset(mResult, -delta, maxArcTolerance()); // can throw
-    ClipperHelpers::offset(mResult, delta, maxArcTolerance()); // can throw
+    const QVector<ClipperLib::Paths>& tiles = mNewCache->tiles;
+    ClipperLib::Clipper c;
+    for (const ClipperLib::Paths& tile : tiles) {
+        c.AddPaths(tile, ClipperLib::ptSubject, true);
+    }
+    c.Execute(ClipperLib::ctUnion, mResult, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
 }
 
 void BoardPlaneFragmentsBuilder::flattenResult()
@@ -224,24 +458,72 @@ void BoardPlaneFragmentsBuilder::removeOrphans()
  *  Helper Methods
  ****************************************************************************************/
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(const BI_FootprintPad& pad) const noexcept
+bool BoardPlaneFragmentsBuilder::needsCutOut(const BI_Plane& plane,
+                                             const NetSignal* netsignal) noexcept
 {
-    bool differentNetSignal = (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-    if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) || differentNetSignal) {
-        return ClipperHelpers::convert(pad.getSceneOutline(mPlane.getMinClearance()), maxArcTolerance());
-    } else {
-        return ClipperLib::Path();
-    }
+    bool differentNetSignal = (netsignal != &plane.getNetSignal());
+    return (plane.getConnectStyle() == BI_Plane::ConnectStyle::None) || differentNetSignal;
 }
 
-ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(const BI_Via& via) const noexcept
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getTileRect(int column, int row) const noexcept
 {
-    bool differentNetSignal = (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-    if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) || differentNetSignal) {
-        return ClipperHelpers::convert(via.getSceneOutline(mPlane.getMinClearance()), maxArcTolerance());
-    } else {
-        return ClipperLib::Path();
-    }
+    ClipperLib::cInt size = tileSize().toNm();
+    ClipperLib::IntRect rect;
+    rect.left = mTileGrid.left + column * size;
+    rect.top = mTileGrid.top + row * size;
+    rect.right = rect.left + size;
+    rect.bottom = rect.top + size;
+    return rect;
+}
+
+bool BoardPlaneFragmentsBuilder::getTileRange(const ClipperLib::IntRect& area,
+    int& firstColumn, int& lastColumn, int& firstRow, int& lastRow) const noexcept
+{
+    // all tiles whose margin overlaps the area
+    ClipperLib::cInt size = tileSize().toNm();
+    ClipperLib::cInt margin = getTileMargin();
+    ClipperLib::cInt left = area.left - margin - mTileGrid.left;
+    ClipperLib::cInt right = area.right + margin - mTileGrid.left;
+    ClipperLib::cInt top = area.top - margin - mTileGrid.top;
+    ClipperLib::cInt bottom = area.bottom + margin - mTileGrid.top;
+    if ((right < 0) || (bottom < 0)) return false;
+    firstColumn = static_cast<int>(qMax(left / size, ClipperLib::cInt(0)));
+    lastColumn = static_cast<int>(qMin(right / size, ClipperLib::cInt(mTileGrid.columns - 1)));
+    firstRow = static_cast<int>(qMax(top / size, ClipperLib::cInt(0)));
+    lastRow = static_cast<int>(qMin(bottom / size, ClipperLib::cInt(mTileGrid.rows - 1)));
+    return (firstColumn <= lastColumn) && (firstRow <= lastRow);
+}
+
+ClipperLib::cInt BoardPlaneFragmentsBuilder::getTileMargin() const noexcept
+{
+    // the minimum width check within a tile depends on the area up to the minimum
+    // width around it
+    return mMinWidth.toNm() + maxArcTolerance().toNm();
+}
+
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getBoundingRect(const Path& path,
+    const Length& expansion) noexcept
+{
+    ClipperLib::Paths paths;
+    paths.push_back(ClipperHelpers::convert(path, maxArcTolerance()));
+    ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(paths);
+    // add the arc tolerance since flattened arcs may be slightly smaller than the arc
+    ClipperLib::cInt margin = expansion.toNm() + maxArcTolerance().toNm();
+    rect.left -= margin;
+    rect.top -= margin;
+    rect.right += margin;
+    rect.bottom += margin;
+    return rect;
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::rectToPath(const ClipperLib::IntRect& rect) noexcept
+{
+    ClipperLib::Path path;
+    path.push_back(ClipperLib::IntPoint(rect.left, rect.top));
+    path.push_back(ClipperLib::IntPoint(rect.right, rect.top));
+    path.push_back(ClipperLib::IntPoint(rect.right, rect.bottom));
+    path.push_back(ClipperLib::IntPoint(rect.left, rect.bottom));
+    return path;
 }
 
 /*****************************************************************************************
@@ -23,9 +23,12 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <clipper/clipper.hpp>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/uuid.h>
+#include "boardclearanceareacache.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -34,8 +37,7 @@ namespace librepcb {
 namespace project {
 
 class BI_Plane;
-class BI_Via;
-class BI_FootprintPad;
+class NetSignal;
 
 /*****************************************************************************************
  *  Class BoardPlaneFragmentsBuilder
@@ -43,46 +45,180 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * The constructor takes a snapshot of all board items which affect the fragments of a
+ * plane, so it must be called from the thread owning the board. Afterwards the board is
+ * not accessed anymore, i.e. #buildFragments() can be called from any thread (e.g. by
+ * librepcb::project::BoardPlanesRebuilder) while the board is being modified.
+ *
+ * The plane area is split into tiles (see #tileSize()) which are built independently
+ * and stitched together afterwards. If the cache of a previous build of the same plane
+ * is passed with #setCache(), only the tiles affected by items which have been added,
+ * removed or modified since that build are recalculated.
+ *
+ * The areas of the board items are taken from a
+ * librepcb::project::BoardClearanceAreaCache, which should be shared between all
+ * planes of a board to avoid creating the same areas again and again.
  */
 class BoardPlaneFragmentsBuilder final
 {
     public:
 
+        // Types
+        struct Cache;
+
         // Constructors / Destructor
         BoardPlaneFragmentsBuilder() = delete;
         BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-        BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+        BoardPlaneFragmentsBuilder(const BI_Plane& plane,
+                                   BoardClearanceAreaCache& areaCache) noexcept;
         ~BoardPlaneFragmentsBuilder() noexcept;
 
+        // Getters
+
+        /**
+         * @brief Get the UUIDs of all planes which this plane depends on
+         *
+         * @see #dependsOn()
+         */
+        QList<Uuid> getDependencies() const noexcept {return mOtherPlaneFragments.keys();}
+
+        /**
+         * @brief Get the cache of the last #buildFragments() call
+         *
+         * @return The cache to pass to the next build of the same plane (nullptr if
+         *         the build failed)
+         */
+        std::shared_ptr<const Cache> getCache() const noexcept {return mNewCache;}
+
+        // Setters
+
+        /**
+         * @brief Replace the snapshot of the fragments of a plane this plane depends on
+         *
+         * By default the fragments of the other planes at the time of the snapshot are
+         * used. If these planes are rebuilt too, their new fragments have to be set
+         * with this method before calling #buildFragments().
+         *
+         * @param plane         UUID of the other plane (see #getDependencies())
+         * @param fragments     The new fragments of the other plane
+         */
+        void setDependencyFragments(const Uuid& plane, const QVector<Path>& fragments) noexcept;
+
+        /**
+         * @brief Set the cache of the previous build of the same plane
+         *
+         * @param cache         See #getCache()
+         */
+        void setCache(const std::shared_ptr<const Cache>& cache) noexcept {mOldCache = cache;}
+
+        /**
+         * @brief Enable or disable the bounding rect prefilter (enabled by default)
+         *
+         * The prefilter skips cut-outs and tiles outside the bounding rect of the plane
+         * area without passing them to Clipper. It does not change the result, so
+         * disabling it is only useful to measure its effect (see the benchmark in the
+         * unit tests).
+         *
+         * @param enabled       Whether the prefilter is used by #buildFragments()
+         */
+        void setBoundingRectPrefilterEnabled(bool enabled) noexcept {
+            mBoundingRectPrefilter = enabled;
+        }
+
         // General Methods
         QVector<Path> buildFragments() noexcept;
 
         // Operator Overloadings
         BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) = delete;
 
+        // Static Methods
+
+        /**
+         * @brief Check whether the fragments of a plane depend on another plane
+         *
+         * This is the case if the other plane has a higher priority, is on the same
+         * layer, belongs to another net signal and its outline (expanded by the
+         * clearance) overlaps the bounding box of the plane's outline. Only the
+         * fragments of these planes are subtracted from the plane.
+         *
+         * @param plane     The plane to check
+         * @param other     The other plane
+         *
+         * @return True if the fragments of "other" must be built before "plane"
+         */
+        static bool dependsOn(const BI_Plane& plane, const BI_Plane& other) noexcept;
+
+        /**
+         * Returns the maximum allowed arc tolerance when flattening arcs. Do not change
+         * this if you don't know exactly what you're doing (it affects all planes in
+         * all existing boards)!
+         */
+        static Length maxArcTolerance() noexcept {return Length(5000);}
+
+
+    private: // Types
+        typedef BoardClearanceAreaCache::ItemKey ItemKey;
+        typedef BoardClearanceAreaCache::Area Area;
+
+        /// Grid of tiles covering the bounding rect of the plane outline
+        struct TileGrid {
+            ClipperLib::cInt left;
+            ClipperLib::cInt top;
+            int columns;
+            int rows;
+        };
+
 
     private: // Methods
+        void takeSnapshot(const BI_Plane& plane, BoardClearanceAreaCache& areaCache) noexcept;
+        bool canReuseTiles() const noexcept;
+        void prepareCutOuts(QVector<ClipperLib::IntRect>& modifiedAreas);
         void addPlaneOutline();
         void clipToBoardOutline();
-        void subtractOtherObjects();
-        void ensureMinimumWidth();
+        void buildTiles(const QVector<ClipperLib::IntRect>* modifiedAreas);
+        ClipperLib::Paths buildTile(const ClipperLib::IntRect& tile,
+                                    const QVector<const Area*>& cutOuts) const;
+        void stitchTiles();
         void flattenResult();
         void removeOrphans();
 
         // Helper Methods
-        ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-        ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
+        static bool needsCutOut(const BI_Plane& plane, const NetSignal* netsignal) noexcept;
+        ClipperLib::IntRect getTileRect(int column, int row) const noexcept;
+        bool getTileRange(const ClipperLib::IntRect& area, int& firstColumn, int& lastColumn,
+                          int& firstRow, int& lastRow) const noexcept;
+        ClipperLib::cInt getTileMargin() const noexcept;
+        static ClipperLib::IntRect getBoundingRect(const Path& path,
+                                                   const Length& expansion) noexcept;
+        static ClipperLib::Path rectToPath(const ClipperLib::IntRect& rect) noexcept;
 
         /**
-         * Returns the maximum allowed arc tolerance when flattening arcs. Do not change
-         * this if you don't know exactly what you're doing (it affects all planes in
-         * all existing boards)!
+         * Returns the edge length of the tiles. Smaller tiles reduce the area to
+         * recalculate after small modifications, but increase the overhead of
+         * building and stitching the tiles.
          */
-        static Length maxArcTolerance() noexcept {return Length(5000);}
+        static Length tileSize() noexcept {return Length(10000000);}
 
 
     private: // Data
-        BI_Plane& mPlane;
+
+        // snapshot of the plane and the board
+        Path mOutline;
+        Length mMinWidth;
+        Length mMinClearance;
+        bool mKeepOrphans;
+        QVector<Path> mBoardOutlines;
+        QMap<Uuid, QVector<Path>> mOtherPlaneFragments; ///< not yet expanded by clearance
+        QMap<ItemKey, std::shared_ptr<const Area>> mCutOuts; ///< expanded by clearance
+        QVector<std::shared_ptr<const Area>> mConnectedAreas; ///< items of the plane's net
+
+        // working data
+        bool mBoundingRectPrefilter;
+        std::shared_ptr<const Cache> mOldCache;
+        std::shared_ptr<Cache> mNewCache;
+        TileGrid mTileGrid;
+        ClipperLib::Paths mPlaneArea;   ///< plane outline clipped to the board outline
         ClipperLib::Paths mConnectedNetSignalAreas;
         ClipperLib::Paths mResult;
 };
@@ -0,0 +1,290 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardplanesrebuilder.h"
+#include <librepcb/common/geometry/path.h>
+#include "board.h"
+#include "items/bi_plane.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct BoardPlanesRebuilder::Run
+ ****************************************************************************************/
+
+/**
+ * @brief The state of one rebuild, shared between the rebuilder and its jobs
+ *
+ * All members except #canceled must only be accessed with #mutex locked.
+ */
+struct BoardPlanesRebuilder::Run final
+{
+    struct Entry {
+        Uuid plane;
+        std::shared_ptr<BoardPlaneFragmentsBuilder> builder;
+        QList<int> dependencies;    ///< indices of entries which must be built before
+        bool started;
+        bool built;
+        QVector<Path> fragments;
+        std::shared_ptr<const BoardPlaneFragmentsBuilder::Cache> cache;
+    };
+
+    BoardPlanesRebuilder* rebuilder;
+    QThreadPool* threadPool;
+    QAtomicInt canceled;
+    QMutex mutex;
+    QWaitCondition jobFinished;
+    QVector<Entry> entries;         ///< sorted by priority (highest priority first)
+    QList<int> newResults;          ///< indices of built but not yet assigned entries
+    int builtCount;
+};
+
+/*****************************************************************************************
+ *  Class BoardPlanesRebuilder::Job
+ ****************************************************************************************/
+
+/**
+ * @brief Builds the fragments of one plane in the thread pool
+ */
+class BoardPlanesRebuilder::Job final : public QRunnable
+{
+    public:
+        Job(const std::shared_ptr<Run>& run, int index) noexcept :
+            QRunnable(), mRun(run), mIndex(index) {}
+
+        void run() noexcept override {
+            if (mRun->canceled.load()) return;
+
+            // the builder is accessed only by this job, but the fragments of the
+            // dependencies must be copied with the mutex locked
+            std::shared_ptr<BoardPlaneFragmentsBuilder> builder;
+            {
+                QMutexLocker locker(&mRun->mutex);
+                const Run::Entry& entry = mRun->entries.at(mIndex);
+                builder = entry.builder;
+                foreach (int dependency, entry.dependencies) {
+                    const Run::Entry& other = mRun->entries.at(dependency);
+                    builder->setDependencyFragments(other.plane, other.fragments);
+                }
+            }
+
+            QVector<Path> fragments = builder->buildFragments();
+
+            {
+                QMutexLocker locker(&mRun->mutex);
+                Run::Entry& entry = mRun->entries[mIndex];
+                entry.fragments = fragments;
+                entry.cache = builder->getCache();
+                entry.built = true;
+                entry.builder.reset(); // release the snapshot as early as possible
+                mRun->newResults.append(mIndex);
+                mRun->builtCount++;
+                startReadyJobs(mRun);
+                mRun->jobFinished.wakeAll();
+            }
+
+            // assign the result in the thread of the board
+            QMetaObject::invokeMethod(mRun->rebuilder, "processResults",
+                                      Qt::QueuedConnection);
+        }
+
+    private:
+        std::shared_ptr<Run> mRun;
+        int mIndex;
+};
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardPlanesRebuilder::BoardPlanesRebuilder(Board& board) noexcept :
+    QObject(nullptr), mBoard(board), mThreadPool(), mCurrentRun(),
+    mAreaCache(BoardPlaneFragmentsBuilder::maxArcTolerance())
+{
+}
+
+BoardPlanesRebuilder::~BoardPlanesRebuilder() noexcept
+{
+    cancel();
+    mThreadPool.waitForDone(); // jobs hold a pointer to this object
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardPlanesRebuilder::startRebuild(const QList<BI_Plane*>& planes) noexcept
+{
+    cancel();
+    if (planes.isEmpty()) return;
+
+    // sort by priority (highest priority first)
+    QList<BI_Plane*> sortedPlanes = planes;
+    qSort(sortedPlanes.begin(), sortedPlanes.end(),
+          [](const BI_Plane* p1, const BI_Plane* p2) {return !(*p1 < *p2);});
+
+    // take the snapshots of all planes (this has to be done in the board's thread)
+    std::shared_ptr<Run> run = std::make_shared<Run>();
+    run->rebuilder = this;
+    run->threadPool = &mThreadPool;
+    run->canceled.store(0);
+    run->builtCount = 0;
+    QHash<Uuid, int> indices;
+    foreach (BI_Plane* plane, sortedPlanes) {
+        Run::Entry entry;
+        entry.plane = plane->getUuid();
+        entry.builder = std::make_shared<BoardPlaneFragmentsBuilder>(*plane, mAreaCache);
+        entry.builder->setCache(mCaches.value(entry.plane));
+        foreach (const Uuid& dependency, entry.builder->getDependencies()) {
+            // planes which are not rebuilt keep the fragments from the snapshot
+            if (indices.contains(dependency)) {
+                entry.dependencies.append(indices.value(dependency));
+            }
+        }
+        entry.started = false;
+        entry.built = false;
+        indices.insert(entry.plane, run->entries.count());
+        run->entries.append(entry);
+        plane->setFragmentsOutdated(true);
+    }
+    mAreaCache.removeUnusedAreas();
+
+    // start building all planes without dependencies
+    mCurrentRun = run;
+    emit rebuildStarted();
+    QMutexLocker locker(&run->mutex);
+    startReadyJobs(run);
+}
+
+void BoardPlanesRebuilder::cancel() noexcept
+{
+    if (mCurrentRun) {
+        mCurrentRun->canceled.store(1);
+        mCurrentRun.reset();
+        emit rebuildFinished();
+    }
+}
+
+void BoardPlanesRebuilder::waitForFinished() noexcept
+{
+    std::shared_ptr<Run> run = mCurrentRun;
+    if (!run) return;
+
+    {
+        QMutexLocker locker(&run->mutex);
+        while (run->builtCount < run->entries.count()) {
+            run->jobFinished.wait(&run->mutex);
+        }
+    }
+    processResults();
+}
+
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void BoardPlanesRebuilder::processResults() noexcept
+{
+    std::shared_ptr<Run> run = mCurrentRun;
+    if (!run) return; // results of canceled runs are discarded
+
+    QList<QPair<Uuid, QVector<Path>>> results;
+    bool finished;
+    {
+        QMutexLocker locker(&run->mutex);
+        foreach (int index, run->newResults) {
+            const Run::Entry& entry = run->entries.at(index);
+            results.append(qMakePair(entry.plane, entry.fragments));
+            if (entry.cache) {
+                mCaches.insert(entry.plane, entry.cache);
+            } else {
+                mCaches.remove(entry.plane); // build failed
+            }
+        }
+        run->newResults.clear();
+        finished = (run->builtCount == run->entries.count());
+    }
+
+    // planes may have been removed from the board in the meantime
+    for (const auto& result : results) {
+        foreach (BI_Plane* plane, mBoard.getPlanes()) {
+            if (plane->getUuid() == result.first) {
+                plane->setFragments(result.second);
+                break;
+            }
+        }
+    }
+
+    if (finished) {
+        // release the caches of removed planes
+        QSet<Uuid> planes;
+        foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+            planes.insert(plane->getUuid());
+        }
+        for (auto it = mCaches.begin(); it != mCaches.end();) {
+            if (planes.contains(it.key())) {
+                ++it;
+            } else {
+                it = mCaches.erase(it);
+            }
+        }
+        mCurrentRun.reset();
+        emit rebuildFinished();
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardPlanesRebuilder::startReadyJobs(const std::shared_ptr<Run>& run) noexcept
+{
+    // note: the mutex of the run must be locked by the caller
+    if (run->canceled.load()) return;
+    for (int i = 0; i < run->entries.count(); ++i) {
+        Run::Entry& entry = run->entries[i];
+        if (entry.started) continue;
+        bool ready = true;
+        foreach (int dependency, entry.dependencies) {
+            if (!run->entries.at(dependency).built) {
+                ready = false;
+                break;
+            }
+        }
+        if (ready) {
+            entry.started = true;
+            run->threadPool->start(new Job(run, i));
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
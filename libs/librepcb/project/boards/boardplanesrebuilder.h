@@ -0,0 +1,141 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+#define LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <memory>
+#include <QtCore>
+#include <librepcb/common/uuid.h>
+#include "boardclearanceareacache.h"
+#include "boardplanefragmentsbuilder.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Plane;
+
+/*****************************************************************************************
+ *  Class BoardPlanesRebuilder
+ ****************************************************************************************/
+
+/**
+ * @brief Rebuilds the fragments of the planes of a board in background threads
+ *
+ * When starting a rebuild, a snapshot of all required board data is taken (see
+ * librepcb::project::BoardPlaneFragmentsBuilder) and the fragments are then built on a
+ * thread pool. Planes which depend on each other are built in the order of their
+ * priority, all other planes are built in parallel. As soon as the fragments of a plane
+ * are available, they are assigned to the plane in the thread owning the board, so
+ * the planes are updated one after the other while the user keeps working.
+ *
+ * Until their new fragments are available, the affected planes keep their old fragments
+ * but are marked as outdated (see librepcb::project::BI_Plane::areFragmentsOutdated()).
+ * Starting a new rebuild cancels the running one, i.e. results of outdated rebuilds are
+ * discarded.
+ *
+ * The cache of the last build of each plane is kept to only recalculate the areas of a
+ * plane which are affected by modifications since then. In addition, the areas of the
+ * board items are cached across all planes and rebuilds.
+ */
+class BoardPlanesRebuilder final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        BoardPlanesRebuilder() = delete;
+        BoardPlanesRebuilder(const BoardPlanesRebuilder& other) = delete;
+        explicit BoardPlanesRebuilder(Board& board) noexcept;
+        ~BoardPlanesRebuilder() noexcept;
+
+        // Getters
+        bool isBusy() const noexcept {return mCurrentRun != nullptr;}
+
+        // General Methods
+
+        /**
+         * @brief Start rebuilding the fragments of some planes in background
+         *
+         * @param planes    The planes to rebuild (must belong to the board)
+         */
+        void startRebuild(const QList<BI_Plane*>& planes) noexcept;
+
+        /**
+         * @brief Cancel the running rebuild (if any)
+         *
+         * The planes which are not rebuilt yet keep their outdated fragments.
+         */
+        void cancel() noexcept;
+
+        /**
+         * @brief Block until the running rebuild (if any) is finished
+         *
+         * All results are assigned to the planes before this method returns.
+         */
+        void waitForFinished() noexcept;
+
+        // Operator Overloadings
+        BoardPlanesRebuilder& operator=(const BoardPlanesRebuilder& rhs) = delete;
+
+
+    signals:
+
+        void rebuildStarted();
+        void rebuildFinished();
+
+
+    private slots:
+
+        void processResults() noexcept;
+
+
+    private: // Types
+        struct Run;
+        class Job;
+
+
+    private: // Methods
+        static void startReadyJobs(const std::shared_ptr<Run>& run) noexcept;
+
+
+    private: // Data
+        Board& mBoard;
+        QThreadPool mThreadPool;
+        std::shared_ptr<Run> mCurrentRun; ///< nullptr if no rebuild is running
+        BoardClearanceAreaCache mAreaCache; ///< shared by all planes, main thread only
+        QHash<Uuid, std::shared_ptr<const BoardPlaneFragmentsBuilder::Cache>> mCaches;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
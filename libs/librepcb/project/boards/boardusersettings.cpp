@@ -97,6 +97,22 @@ bool BoardUserSettings::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool BoardUserSettings::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                              QStringList& errors) noexcept
+{
+    bool success = true;
+
+    try {
+        SExpression doc(serializeToDomElement("librepcb_board_user_settings"));
+        snapshots.append(mFile->createSnapshot(doc)); // can throw
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
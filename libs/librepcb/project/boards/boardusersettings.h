@@ -26,13 +26,13 @@
 #include <QtCore>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class SmartSExprFile;
 class GraphicsLayerStackAppearanceSettings;
 
 namespace project {
@@ -61,6 +61,8 @@ class BoardUserSettings final : public QObject, public SerializableObject
 
         // General Methods
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
 
         // Operator Overloadings
         BoardUserSettings& operator=(const BoardUserSettings& rhs) = delete;
@@ -59,12 +59,14 @@ bool CmdBoardDesignRulesModify::performExecute()
 
 void CmdBoardDesignRulesModify::performUndo()
 {
+    mBoard.setModified();
     mBoard.getDesignRules() = mOldRules;
     emit mBoard.attributesChanged();
 }
 
 void CmdBoardDesignRulesModify::performRedo()
 {
+    mBoard.setModified();
     mBoard.getDesignRules() = mNewRules;
     emit mBoard.attributesChanged();
 }
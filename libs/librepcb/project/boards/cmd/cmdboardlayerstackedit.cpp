@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdboardlayerstackedit.h"
 #include "../boardlayerstack.h"
+#include "../board.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -68,11 +69,13 @@ bool CmdBoardLayerStackEdit::performExecute()
 
 void CmdBoardLayerStackEdit::performUndo()
 {
+    mLayerStack.getBoard().setModified();
     mLayerStack.setInnerLayerCount(mOldInnerLayerCount);
 }
 
 void CmdBoardLayerStackEdit::performRedo()
 {
+    mLayerStack.getBoard().setModified();
     mLayerStack.setInnerLayerCount(mNewInnerLayerCount);
 }
 
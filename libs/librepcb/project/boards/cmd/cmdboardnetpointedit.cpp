@@ -26,6 +26,7 @@
 #include "../items/bi_netpoint.h"
 #include "../items/bi_footprintpad.h"
 #include "../items/bi_via.h"
+#include "../board.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -104,6 +105,7 @@ bool CmdBoardNetPointEdit::performExecute()
 
 void CmdBoardNetPointEdit::performUndo()
 {
+    mNetPoint.getBoard().setModified();
     ScopeGuardList sgl;
     mNetPoint.setLayer(*mOldLayer); // can throw
     sgl.add([&](){mNetPoint.setLayer(*mNewLayer);});
@@ -117,6 +119,7 @@ void CmdBoardNetPointEdit::performUndo()
 
 void CmdBoardNetPointEdit::performRedo()
 {
+    mNetPoint.getBoard().setModified();
     ScopeGuardList sgl;
     mNetPoint.setLayer(*mNewLayer); // can throw
     sgl.add([&](){mNetPoint.setLayer(*mOldLayer);});
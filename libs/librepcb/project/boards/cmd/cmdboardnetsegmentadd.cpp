@@ -71,11 +71,13 @@ bool CmdBoardNetSegmentAdd::performExecute()
 
 void CmdBoardNetSegmentAdd::performUndo()
 {
+    mBoard.setModified();
     mBoard.removeNetSegment(*mNetSegment); // can throw
 }
 
 void CmdBoardNetSegmentAdd::performRedo()
 {
+    mBoard.setModified();
     mBoard.addNetSegment(*mNetSegment); // can throw
 }
 
@@ -25,6 +25,7 @@
 #include "../items/bi_netpoint.h"
 #include "../items/bi_netline.h"
 #include "../items/bi_netsegment.h"
+#include "../board.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -116,11 +117,13 @@ bool CmdBoardNetSegmentAddElements::performExecute()
 
 void CmdBoardNetSegmentAddElements::performUndo()
 {
+    mNetSegment.getBoard().setModified();
     mNetSegment.removeElements(mVias, mNetPoints, mNetLines); // can throw
 }
 
 void CmdBoardNetSegmentAddElements::performRedo()
 {
+    mNetSegment.getBoard().setModified();
     mNetSegment.addElements(mVias, mNetPoints, mNetLines); // can throw
 }
 
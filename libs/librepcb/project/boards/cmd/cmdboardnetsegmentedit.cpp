@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdboardnetsegmentedit.h"
 #include "../items/bi_netsegment.h"
+#include "../board.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -67,11 +68,13 @@ bool CmdBoardNetSegmentEdit::performExecute()
 
 void CmdBoardNetSegmentEdit::performUndo()
 {
+    mNetSegment.getBoard().setModified();
     mNetSegment.setNetSignal(*mOldNetSignal); // can throw
 }
 
 void CmdBoardNetSegmentEdit::performRedo()
 {
+    mNetSegment.getBoard().setModified();
     mNetSegment.setNetSignal(*mNewNetSignal); // can throw
 }
 
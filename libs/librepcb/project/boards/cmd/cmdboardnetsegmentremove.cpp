@@ -58,11 +58,13 @@ bool CmdBoardNetSegmentRemove::performExecute()
 
 void CmdBoardNetSegmentRemove::performUndo()
 {
+    mBoard.setModified();
     mBoard.addNetSegment(mNetSegment); // can throw
 }
 
 void CmdBoardNetSegmentRemove::performRedo()
 {
+    mBoard.setModified();
     mBoard.removeNetSegment(mNetSegment); // can throw
 }
 
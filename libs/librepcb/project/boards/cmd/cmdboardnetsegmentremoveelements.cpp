@@ -79,11 +79,13 @@ bool CmdBoardNetSegmentRemoveElements::performExecute()
 
 void CmdBoardNetSegmentRemoveElements::performUndo()
 {
+    mNetSegment.getBoard().setModified();
     mNetSegment.addElements(mVias, mNetPoints, mNetLines); // can throw
 }
 
 void CmdBoardNetSegmentRemoveElements::performRedo()
 {
+    mNetSegment.getBoard().setModified();
     mNetSegment.removeElements(mVias, mNetPoints, mNetLines); // can throw
 }
 
@@ -57,11 +57,13 @@ bool CmdBoardPlaneAdd::performExecute()
 
 void CmdBoardPlaneAdd::performUndo()
 {
+    mBoard.setModified();
     mBoard.removePlane(mPlane);
 }
 
 void CmdBoardPlaneAdd::performRedo()
 {
+    mBoard.setModified();
     mBoard.addPlane(mPlane);
 }
 
@@ -144,6 +144,7 @@ bool CmdBoardPlaneEdit::performExecute()
 
 void CmdBoardPlaneEdit::performUndo()
 {
+    mPlane.getBoard().setModified();
     mPlane.setNetSignal(*mOldNetSignal); // can throw
     mPlane.setOutline(mOldOutline);
     mPlane.setLayerName(mOldLayerName);
@@ -154,11 +155,12 @@ void CmdBoardPlaneEdit::performUndo()
     mPlane.setKeepOrphans(mOldKeepOrphans);
 
     // rebuild all planes to see the changes
-    if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+    if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanesInBackground();
 }
 
 void CmdBoardPlaneEdit::performRedo()
 {
+    mPlane.getBoard().setModified();
     mPlane.setNetSignal(*mNewNetSignal); // can throw
     mPlane.setOutline(mNewOutline);
     mPlane.setLayerName(mNewLayerName);
@@ -169,7 +171,7 @@ void CmdBoardPlaneEdit::performRedo()
     mPlane.setKeepOrphans(mNewKeepOrphans);
 
     // rebuild all planes to see the changes
-    if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+    if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanesInBackground();
 }
 
 /*****************************************************************************************
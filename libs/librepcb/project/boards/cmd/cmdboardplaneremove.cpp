@@ -58,11 +58,13 @@ bool CmdBoardPlaneRemove::performExecute()
 
 void CmdBoardPlaneRemove::performUndo()
 {
+    mBoard.setModified();
     mBoard.addPlane(mPlane); // can throw
 }
 
 void CmdBoardPlaneRemove::performRedo()
 {
+    mBoard.setModified();
     mBoard.removePlane(mPlane); // can throw
 }
 
@@ -57,11 +57,13 @@ bool CmdBoardPolygonAdd::performExecute()
 
 void CmdBoardPolygonAdd::performUndo()
 {
+    mBoard.setModified();
     mBoard.removePolygon(mPolygon);
 }
 
 void CmdBoardPolygonAdd::performRedo()
 {
+    mBoard.setModified();
     mBoard.addPolygon(mPolygon);
 }
 
@@ -58,11 +58,13 @@ bool CmdBoardPolygonRemove::performExecute()
 
 void CmdBoardPolygonRemove::performUndo()
 {
+    mBoard.setModified();
     mBoard.addPolygon(mPolygon); // can throw
 }
 
 void CmdBoardPolygonRemove::performRedo()
 {
+    mBoard.setModified();
     mBoard.removePolygon(mPolygon); // can throw
 }
 
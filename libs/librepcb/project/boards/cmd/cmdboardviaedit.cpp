@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdboardviaedit.h"
 #include "../items/bi_via.h"
+#include "../board.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -105,6 +106,7 @@ bool CmdBoardViaEdit::performExecute()
 
 void CmdBoardViaEdit::performUndo()
 {
+    mVia.getBoard().setModified();
     mVia.setPosition(mOldPos);
     mVia.setShape(mOldShape);
     mVia.setSize(mOldSize);
@@ -113,6 +115,7 @@ void CmdBoardViaEdit::performUndo()
 
 void CmdBoardViaEdit::performRedo()
 {
+    mVia.getBoard().setModified();
     mVia.setPosition(mNewPos);
     mVia.setShape(mNewShape);
     mVia.setSize(mNewSize);
@@ -73,11 +73,13 @@ bool CmdDeviceInstanceAdd::performExecute()
 
 void CmdDeviceInstanceAdd::performUndo()
 {
+    mBoard.setModified();
     mBoard.removeDeviceInstance(*mDeviceInstance);
 }
 
 void CmdDeviceInstanceAdd::performRedo()
 {
+    mBoard.setModified();
     mBoard.addDeviceInstance(*mDeviceInstance);
 }
 
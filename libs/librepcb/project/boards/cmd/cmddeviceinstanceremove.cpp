@@ -58,11 +58,13 @@ bool CmdDeviceInstanceRemove::performExecute()
 
 void CmdDeviceInstanceRemove::performUndo()
 {
+    mBoard.setModified();
     mBoard.addDeviceInstance(mDevice); // can throw
 }
 
 void CmdDeviceInstanceRemove::performRedo()
 {
+    mBoard.setModified();
     mBoard.removeDeviceInstance(mDevice); // can throw
 }
 
@@ -78,9 +78,6 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
 
     mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
-    mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
-    mBoundingRect.adjust(-mNetLine.getWidth().toPx()/2, -mNetLine.getWidth().toPx()/2,
-                         mNetLine.getWidth().toPx()/2, mNetLine.getWidth().toPx()/2);
     mShape = QPainterPath();
     mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
@@ -89,6 +86,8 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept
     Length width = (mNetLine.getWidth() > Length(100000) ? mNetLine.getWidth() : Length(100000));
     ps.setWidth(width.toPx());
     mShape = ps.createStroke(mShape);
+    // thin traces have a wider grab area, which must be found by the scene index too
+    mBoundingRect = mShape.boundingRect();
     update();
 }
 
@@ -106,9 +106,13 @@ void BGI_Plane::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
         painter->setBrush(Qt::NoBrush);
         painter->drawPath(mOutline);
 
-        // draw plane
+        // draw plane (outdated fragments are hatched until the rebuild has finished)
         painter->setPen(Qt::NoPen);
-        painter->setBrush(mLayer->getColor(selected));
+        if (mPlane.areFragmentsOutdated()) {
+            painter->setBrush(QBrush(mLayer->getColor(selected), Qt::Dense4Pattern));
+        } else {
+            painter->setBrush(mLayer->getColor(selected));
+        }
         foreach (const QPainterPath& area, mAreas) {
             painter->drawPath(area);
         }
@@ -33,12 +33,19 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+QAtomicInteger<quint64> BI_Base::sNextGeometryRevision(1);
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept :
-    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
+    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false),
+    mGeometryRevision(sNextGeometryRevision.fetchAndAddRelaxed(1))
 {
 }
 
@@ -78,6 +85,7 @@ void BI_Base::addToBoard(QGraphicsItem* item) noexcept
 {
     Q_ASSERT(!mIsAddedToBoard);
     if (item) {
+        item->setData(sGraphicsItemOwnerDataKey, QVariant::fromValue<QObject*>(this));
         mBoard.getGraphicsScene().addItem(*item);
     }
     mIsAddedToBoard = true;
@@ -92,6 +100,20 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept
     mIsAddedToBoard = false;
 }
 
+void BI_Base::geometryModified() noexcept
+{
+    mGeometryRevision = sNextGeometryRevision.fetchAndAddRelaxed(1);
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+BI_Base* BI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept
+{
+    return qobject_cast<BI_Base*>(item.data(sGraphicsItemOwnerDataKey).value<QObject*>());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -85,6 +85,15 @@ class BI_Base : public QObject
         virtual bool isSelectable() const noexcept = 0;
         virtual bool isSelected() const noexcept {return mIsSelected;}
 
+        /**
+         * @brief Get the revision of the copper geometry of this item
+         *
+         * The revision changes whenever the outline of the item changes, and revisions
+         * are never reused (not even by other items). This allows to cache data derived
+         * from the geometry (see librepcb::project::BoardClearanceAreaCache).
+         */
+        quint64 getGeometryRevision() const noexcept {return mGeometryRevision;}
+
         // Setters
         virtual void setSelected(bool selected) noexcept;
 
@@ -95,12 +104,28 @@ class BI_Base : public QObject
         // Operator Overloadings
         BI_Base& operator=(const BI_Base& rhs) = delete;
 
+        // Static Methods
+
+        /**
+         * @brief Get the board item which has added a graphics item to the board
+         *
+         * This allows to use the spatial index of the board's graphics scene to look up
+         * board items by position.
+         *
+         * @param item  A graphics item of the board's graphics scene
+         *
+         * @return The owning board item, or nullptr if the graphics item does not belong
+         *         to a board item
+         */
+        static BI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 
     protected:
 
         // General Methods
         void addToBoard(QGraphicsItem* item) noexcept;
         void removeFromBoard(QGraphicsItem* item) noexcept;
+        void geometryModified() noexcept;
 
 
     protected:
@@ -110,9 +135,16 @@ class BI_Base : public QObject
 
     private:
 
+        /// The key of the QGraphicsItem::data() entry which points to the owning item
+        static constexpr int sGraphicsItemOwnerDataKey = 0;
+
         // General Attributes
         bool mIsAddedToBoard;
         bool mIsSelected;
+        quint64 mGeometryRevision;
+
+        // Static Attributes
+        static QAtomicInteger<quint64> sNextGeometryRevision;
 };
 
 /*****************************************************************************************
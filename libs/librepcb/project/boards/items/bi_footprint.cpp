@@ -244,6 +244,7 @@ void BI_Footprint::deviceInstanceAttributesChanged()
 void BI_Footprint::deviceInstanceMoved(const Point& pos)
 {
     mGraphicsItem->setPos(pos.toPxQPointF());
+    geometryModified(); // holes have moved
     mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
@@ -254,6 +255,7 @@ void BI_Footprint::deviceInstanceRotated(const Angle& rot)
 {
     Q_UNUSED(rot);
     updateGraphicsItemTransform();
+    geometryModified(); // holes have moved
     mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
@@ -264,6 +266,7 @@ void BI_Footprint::deviceInstanceMirrored(bool mirrored)
 {
     Q_UNUSED(mirrored);
     updateGraphicsItemTransform();
+    geometryModified(); // holes have moved
     mGraphicsItem->updateCacheAndRepaint();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
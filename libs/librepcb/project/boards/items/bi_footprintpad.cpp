@@ -180,6 +180,7 @@ void BI_FootprintPad::updatePosition() noexcept
 {
     mPosition = mFootprint.mapToScene(mFootprintPad->getPosition());
     mRotation = mFootprint.getRotation() + mFootprintPad->getRotation();
+    geometryModified();
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
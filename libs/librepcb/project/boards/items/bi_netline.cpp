@@ -185,6 +185,7 @@ void BI_NetLine::setWidth(const Length& width) noexcept
     Q_ASSERT(width >= 0);
     if ((width != mWidth) && (width >= 0)) {
         mWidth = width;
+        geometryModified();
         mGraphicsItem->updateCacheAndRepaint();
     }
 }
@@ -234,6 +235,7 @@ void BI_NetLine::removeFromBoard()
 void BI_NetLine::updateLine() noexcept
 {
     mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
+    geometryModified();
     mGraphicsItem->updateCacheAndRepaint();
 }
 
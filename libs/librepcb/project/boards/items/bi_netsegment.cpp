@@ -449,14 +449,21 @@ void BI_NetSegment::removeFromBoard()
     sgl.dismiss();
 }
 
-void BI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept
+void BI_NetSegment::setSelectionRect(const QRectF rectPx,
+                                     const QSet<const BI_Base*>& candidates) noexcept
 {
+    // items which are not in the candidates list can't be within the rect, so the
+    // (expensive) check of the grab area can be skipped for them
+    auto isInRect = [&](const BI_Base& item) {
+        return candidates.contains(&item) && item.isSelectable()
+            && item.getGrabAreaScenePx().intersects(rectPx);
+    };
     foreach (BI_Via* via, mVias)
-        via->setSelected(via->isSelectable() && via->getGrabAreaScenePx().intersects(rectPx));
+        via->setSelected(isInRect(*via));
     foreach (BI_NetPoint* netpoint, mNetPoints)
-        netpoint->setSelected(netpoint->isSelectable() && netpoint->getGrabAreaScenePx().intersects(rectPx));
+        netpoint->setSelected(isInRect(*netpoint));
     foreach (BI_NetLine* netline, mNetLines)
-        netline->setSelected(netline->isSelectable() && netline->getGrabAreaScenePx().intersects(rectPx));
+        netline->setSelected(isInRect(*netline));
 }
 
 void BI_NetSegment::clearSelection() const noexcept
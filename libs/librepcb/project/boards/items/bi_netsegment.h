@@ -101,7 +101,8 @@ class BI_NetSegment final : public BI_Base, public SerializableObject
         // General Methods
         void addToBoard() override;
         void removeFromBoard() override;
-        void setSelectionRect(const QRectF rectPx) noexcept;
+        void setSelectionRect(const QRectF rectPx,
+                              const QSet<const BI_Base*>& candidates) noexcept;
         void clearSelection() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
@@ -46,13 +46,14 @@ BI_Plane::BI_Plane(Board& board, const BI_Plane& other) :
     mKeepOrphans(other.mKeepOrphans), mPriority(other.mPriority),
     mConnectStyle(other.mConnectStyle),
     //mThermalGapWidth(other.mThermalGapWidth), mThermalSpokeWidth(other.mThermalSpokeWidth),
-    mFragments(other.mFragments) // also copy fragments to avoid the need for a rebuild
+    mFragments(other.mFragments), // also copy fragments to avoid the need for a rebuild
+    mFragmentsOutdated(other.mFragmentsOutdated)
 {
     init();
 }
 
 BI_Plane::BI_Plane(Board& board, const SExpression& node) :
-    BI_Base(board)
+    BI_Base(board), mFragmentsOutdated(false)
 {
     mUuid = node.getChildByIndex(0).getValue<Uuid>(true);
     mLayerName = node.getValueByPath<QString>("layer", true);
@@ -87,7 +88,7 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const QString& layerName,
     mOutline(outline), mMinWidth(200000), mMinClearance(300000), mKeepOrphans(false),
     mPriority(0), mConnectStyle(ConnectStyle::Solid),
     //mThermalGapWidth(100000), mThermalSpokeWidth(100000),
-    mFragments()
+    mFragments(), mFragmentsOutdated(false)
 {
     init();
 }
@@ -178,6 +179,21 @@ void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept
     }
 }
 
+void BI_Plane::setFragments(const QVector<Path>& fragments) noexcept
+{
+    mFragments = fragments;
+    mFragmentsOutdated = false;
+    mGraphicsItem->updateCacheAndRepaint();
+}
+
+void BI_Plane::setFragmentsOutdated(bool outdated) noexcept
+{
+    if (outdated != mFragmentsOutdated) {
+        mFragmentsOutdated = outdated;
+        mGraphicsItem->update();
+    }
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -204,14 +220,15 @@ void BI_Plane::removeFromBoard()
 void BI_Plane::clear() noexcept
 {
     mFragments.clear();
+    mFragmentsOutdated = false;
     mGraphicsItem->updateCacheAndRepaint();
 }
 
 void BI_Plane::rebuild() noexcept
 {
-    BoardPlaneFragmentsBuilder builder(*this);
-    mFragments = builder.buildFragments();
-    mGraphicsItem->updateCacheAndRepaint();
+    BoardClearanceAreaCache areaCache(BoardPlaneFragmentsBuilder::maxArcTolerance());
+    BoardPlaneFragmentsBuilder builder(*this, areaCache);
+    setFragments(builder.buildFragments());
 }
 
 void BI_Plane::serialize(SExpression& root) const
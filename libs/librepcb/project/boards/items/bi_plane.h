@@ -85,6 +85,7 @@ class BI_Plane final : public BI_Base, public SerializableObject
         //const Length& getThermalSpokeWidth() const noexcept {return mThermalSpokeWidth;}
         const Path& getOutline() const noexcept {return mOutline;}
         const QVector<Path>& getFragments() const noexcept {return mFragments;}
+        bool areFragmentsOutdated() const noexcept {return mFragmentsOutdated;}
         bool isSelectable() const noexcept override;
 
         // Setters
@@ -96,6 +97,8 @@ class BI_Plane final : public BI_Base, public SerializableObject
         void setConnectStyle(ConnectStyle style) noexcept;
         void setPriority(int priority) noexcept;
         void setKeepOrphans(bool keepOrphans) noexcept;
+        void setFragments(const QVector<Path>& fragments) noexcept;
+        void setFragmentsOutdated(bool outdated) noexcept;
 
         // General Methods
         void addToBoard() override;
@@ -143,6 +146,7 @@ class BI_Plane final : public BI_Base, public SerializableObject
         QScopedPointer<BGI_Plane> mGraphicsItem;
 
         QVector<Path> mFragments;
+        bool mFragmentsOutdated; ///< true while a rebuild of the fragments is pending
 };
 
 /*****************************************************************************************
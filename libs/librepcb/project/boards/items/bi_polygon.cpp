@@ -75,10 +75,14 @@ void BI_Polygon::init()
 
     // connect to the "attributes changed" signal of the board
     connect(&mBoard, &Board::attributesChanged, this, &BI_Polygon::boardAttributesChanged);
+
+    // every modification of the polygon needs to be saved to the board file
+    mPolygon->registerObserver(*this);
 }
 
 BI_Polygon::~BI_Polygon() noexcept
 {
+    mPolygon->unregisterObserver(*this);
     mGraphicsItem.reset();
     mPolygon.reset();
 }
@@ -129,6 +133,40 @@ void BI_Polygon::setSelected(bool selected) noexcept
     mGraphicsItem->setSelected(selected);
 }
 
+/*****************************************************************************************
+ *  Inherited from IF_PolygonObserver
+ ****************************************************************************************/
+
+void BI_Polygon::polygonLayerNameChanged(const QString& newLayerName) noexcept
+{
+    Q_UNUSED(newLayerName);
+    mBoard.setModified();
+}
+
+void BI_Polygon::polygonLineWidthChanged(const Length& newLineWidth) noexcept
+{
+    Q_UNUSED(newLineWidth);
+    mBoard.setModified();
+}
+
+void BI_Polygon::polygonIsFilledChanged(bool newIsFilled) noexcept
+{
+    Q_UNUSED(newIsFilled);
+    mBoard.setModified();
+}
+
+void BI_Polygon::polygonIsGrabAreaChanged(bool newIsGrabArea) noexcept
+{
+    Q_UNUSED(newIsGrabArea);
+    mBoard.setModified();
+}
+
+void BI_Polygon::polygonPathChanged(const Path& newPath) noexcept
+{
+    Q_UNUSED(newPath);
+    mBoard.setModified();
+}
+
 /*****************************************************************************************
  *  Private Slots
  ****************************************************************************************/
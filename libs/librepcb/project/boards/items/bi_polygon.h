@@ -27,14 +27,13 @@
 #include "bi_base.h"
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/geometry/polygon.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class Path;
-class Polygon;
 class PolygonGraphicsItem;
 
 namespace project {
@@ -53,7 +52,7 @@ class BGI_Polygon;
  * @author ubruhin
  * @date 2016-01-12
  */
-class BI_Polygon final : public BI_Base, public SerializableObject
+class BI_Polygon final : public BI_Base, public SerializableObject, public IF_PolygonObserver
 {
         Q_OBJECT
 
@@ -88,6 +87,13 @@ class BI_Polygon final : public BI_Base, public SerializableObject
         QPainterPath getGrabAreaScenePx() const noexcept override;
         void setSelected(bool selected) noexcept override;
 
+        // Inherited from IF_PolygonObserver
+        void polygonLayerNameChanged(const QString& newLayerName) noexcept override;
+        void polygonLineWidthChanged(const Length& newLineWidth) noexcept override;
+        void polygonIsFilledChanged(bool newIsFilled) noexcept override;
+        void polygonIsGrabAreaChanged(bool newIsGrabArea) noexcept override;
+        void polygonPathChanged(const Path& newPath) noexcept override;
+
         // Operator Overloadings
         BI_Polygon& operator=(const BI_Polygon& rhs) = delete;
 
@@ -148,6 +148,7 @@ void BI_Via::setPosition(const Point& position) noexcept
 {
     if (position != mPosition) {
         mPosition = position;
+        geometryModified();
         mGraphicsItem->setPos(mPosition.toPxQPointF());
         updateNetPoints();
     }
@@ -157,6 +158,7 @@ void BI_Via::setShape(Shape shape) noexcept
 {
     if (shape != mShape) {
         mShape = shape;
+        geometryModified();
         mGraphicsItem->updateCacheAndRepaint();
     }
 }
@@ -165,6 +167,7 @@ void BI_Via::setSize(const Length& size) noexcept
 {
     if (size != mSize) {
         mSize = size;
+        geometryModified();
         mGraphicsItem->updateCacheAndRepaint();
     }
 }
@@ -369,6 +369,10 @@ void Circuit::setComponentInstanceName(ComponentInstance& cmp, const QString& ne
 
 bool Circuit::save(bool toOriginal, QStringList& errors) noexcept
 {
+    if (!mFile->isModified(toOriginal)) {
+        return true; // the file is up to date
+    }
+
     bool success = true;
 
     // Save "core/circuit.lp"
@@ -386,6 +390,26 @@ bool Circuit::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Circuit::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                    QStringList& errors) noexcept
+{
+    if (!mFile->isModified(false)) {
+        return true; // the file is up to date
+    }
+
+    bool success = true;
+
+    try {
+        SExpression doc(serializeToDomElement("librepcb_circuit"));
+        snapshots.append(mFile->createSnapshot(doc)); // can throw
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
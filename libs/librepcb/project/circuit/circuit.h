@@ -28,14 +28,13 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class SmartSExprFile;
-
 namespace library {
 class Component;
 }
@@ -112,7 +111,11 @@ class Circuit final : public QObject, public SerializableObject
         void setComponentInstanceName(ComponentInstance& cmp, const QString& newName);
 
         // General Methods
+        bool isModified(bool original) const noexcept {return mFile->isModified(original);}
+        void setModified() noexcept {mFile->setModified();}
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
 
         // Operator Overloadings
         Circuit& operator=(const Circuit& rhs) = delete;
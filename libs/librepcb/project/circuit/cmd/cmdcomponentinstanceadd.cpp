@@ -75,11 +75,13 @@ bool CmdComponentInstanceAdd::performExecute()
 
 void CmdComponentInstanceAdd::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.removeComponentInstance(*mComponentInstance); // can throw
 }
 
 void CmdComponentInstanceAdd::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.addComponentInstance(*mComponentInstance); // can throw
 }
 
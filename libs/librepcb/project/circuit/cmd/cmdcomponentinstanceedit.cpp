@@ -85,6 +85,7 @@ bool CmdComponentInstanceEdit::performExecute()
 
 void CmdComponentInstanceEdit::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.setComponentInstanceName(mComponentInstance, mOldName); // can throw
     mComponentInstance.setValue(mOldValue);
     mComponentInstance.setAttributes(mOldAttributes);
@@ -92,6 +93,7 @@ void CmdComponentInstanceEdit::performUndo()
 
 void CmdComponentInstanceEdit::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.setComponentInstanceName(mComponentInstance, mNewName); // can throw
     mComponentInstance.setValue(mNewValue);
     mComponentInstance.setAttributes(mNewAttributes);
@@ -59,11 +59,13 @@ bool CmdComponentInstanceRemove::performExecute()
 
 void CmdComponentInstanceRemove::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.addComponentInstance(mComponentInstance); // can throw
 }
 
 void CmdComponentInstanceRemove::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.removeComponentInstance(mComponentInstance); // can throw
 }
 
@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdcompsiginstsetnetsignal.h"
 #include "../componentsignalinstance.h"
+#include "../circuit.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -59,11 +60,13 @@ bool CmdCompSigInstSetNetSignal::performExecute()
 
 void CmdCompSigInstSetNetSignal::performUndo()
 {
+    mComponentSignalInstance.getCircuit().setModified();
     mComponentSignalInstance.setNetSignal(mOldNetSignal); // can throw
 }
 
 void CmdCompSigInstSetNetSignal::performRedo()
 {
+    mComponentSignalInstance.getCircuit().setModified();
     mComponentSignalInstance.setNetSignal(mNetSignal); // can throw
 }
 
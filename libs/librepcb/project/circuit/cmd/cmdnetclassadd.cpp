@@ -60,11 +60,13 @@ bool CmdNetClassAdd::performExecute()
 
 void CmdNetClassAdd::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.removeNetClass(*mNetClass); // can throw
 }
 
 void CmdNetClassAdd::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.addNetClass(*mNetClass); // can throw
 }
 
@@ -68,11 +68,13 @@ bool CmdNetClassEdit::performExecute()
 
 void CmdNetClassEdit::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.setNetClassName(mNetClass, mOldName); // can throw
 }
 
 void CmdNetClassEdit::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.setNetClassName(mNetClass, mNewName); // can throw
 }
 
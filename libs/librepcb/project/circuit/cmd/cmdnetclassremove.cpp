@@ -58,11 +58,13 @@ bool CmdNetClassRemove::performExecute()
 
 void CmdNetClassRemove::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.addNetClass(mNetClass); // can throw
 }
 
 void CmdNetClassRemove::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.removeNetClass(mNetClass); // can throw
 }
 
@@ -71,11 +71,13 @@ bool CmdNetSignalAdd::performExecute()
 
 void CmdNetSignalAdd::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.removeNetSignal(*mNetSignal); // can throw
 }
 
 void CmdNetSignalAdd::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.addNetSignal(*mNetSignal); // can throw
 }
 
@@ -70,11 +70,13 @@ bool CmdNetSignalEdit::performExecute()
 
 void CmdNetSignalEdit::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.setNetSignalName(mNetSignal, mOldName, mOldIsAutoName); // can throw
 }
 
 void CmdNetSignalEdit::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.setNetSignalName(mNetSignal, mNewName, mNewIsAutoName); // can throw
 }
 
@@ -58,11 +58,13 @@ bool CmdNetSignalRemove::performExecute()
 
 void CmdNetSignalRemove::performUndo()
 {
+    mCircuit.setModified();
     mCircuit.addNetSignal(mNetSignal); // can throw
 }
 
 void CmdNetSignalRemove::performRedo()
 {
+    mCircuit.setModified();
     mCircuit.removeNetSignal(mNetSignal); // can throw
 }
 
@@ -62,6 +62,7 @@ void ErcMsg::setMsg(const QString& msg) noexcept
 void ErcMsg::setVisible(bool visible) noexcept
 {
     if (visible == mIsVisible) return;
+    if (mIsIgnored) mErcMsgList.setModified(); // ignored messages are saved in the list
     mIsVisible = visible;
     mIsIgnored = false; // changing the visibility will always reset the ignore flag!
 
@@ -75,6 +76,7 @@ void ErcMsg::setIgnored(bool ignored) noexcept
 {
     if (ignored == mIsIgnored) return;
     mIsIgnored = ignored;
+    mErcMsgList.setModified();
     mErcMsgList.update(this);
 }
 
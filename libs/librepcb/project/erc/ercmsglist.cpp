@@ -110,6 +110,10 @@ void ErcMsgList::restoreIgnoreState()
 
 bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
 {
+    if (!mFile->isModified(toOriginal)) {
+        return true; // the file is up to date
+    }
+
     bool success = true;
 
     // Save "core/erc.lp"
@@ -127,6 +131,26 @@ bool ErcMsgList::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool ErcMsgList::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                       QStringList& errors) noexcept
+{
+    if (!mFile->isModified(false)) {
+        return true; // the file is up to date
+    }
+
+    bool success = true;
+
+    try {
+        SExpression doc(serializeToDomElement("librepcb_erc"));
+        snapshots.append(mFile->createSnapshot(doc)); // can throw
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -27,14 +27,13 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class SmartSExprFile;
-
 namespace project {
 
 class Project;
@@ -67,7 +66,11 @@ class ErcMsgList final : public QObject, public SerializableObject
         void remove(ErcMsg* ercMsg) noexcept;
         void update(ErcMsg* ercMsg) noexcept;
         void restoreIgnoreState();
+        bool isModified(bool original) const noexcept {return mFile->isModified(original);}
+        void setModified() noexcept {mFile->setModified();}
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
         
         // Operator Overloadings
         ErcMsgList& operator=(const ErcMsgList& rhs) = delete;
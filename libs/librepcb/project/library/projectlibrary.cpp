@@ -20,6 +20,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <functional>
 #include <QtCore>
 #include <librepcb/common/exceptions.h>
 #include "projectlibrary.h"
@@ -40,6 +41,55 @@ namespace project {
 
 using namespace library;
 
+/*****************************************************************************************
+ *  Struct ProjectLibrary::LoadedElement
+ ****************************************************************************************/
+
+/**
+ * @brief The result of loading one library element in a worker thread
+ */
+struct ProjectLibrary::LoadedElement final
+{
+    FilePath directory;
+    std::function<LibraryBaseElement*(const FilePath&)> load;
+    std::unique_ptr<LibraryBaseElement> element;    ///< nullptr on error
+    std::shared_ptr<Exception> error;               ///< nullptr on success
+};
+
+/*****************************************************************************************
+ *  Class ProjectLibrary::LoadElementJob
+ ****************************************************************************************/
+
+/**
+ * @brief Loads one library element in the thread pool
+ *
+ * The element is moved to the thread of the project library after loading, so it can be
+ * used as if it was created there (see librepcb::library::LibraryBaseElement for the
+ * rules of loading elements in other threads).
+ */
+class ProjectLibrary::LoadElementJob final : public QRunnable
+{
+    public:
+        LoadElementJob(const std::shared_ptr<LoadedElement>& result,
+                       QThread* targetThread) noexcept :
+            QRunnable(), mResult(result), mTargetThread(targetThread) {}
+
+        void run() noexcept override {
+            try {
+                mResult->element.reset(mResult->load(mResult->directory)); // can throw
+                mResult->element->moveToThread(mTargetThread);
+            } catch (const Exception& e) {
+                mResult->error.reset(e.clone());
+            } catch (...) {
+                mResult->error = std::make_shared<LogicError>(__FILE__, __LINE__);
+            }
+        }
+
+    private:
+        std::shared_ptr<LoadedElement> mResult;
+        QThread* mTargetThread;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -58,11 +108,19 @@ ProjectLibrary::ProjectLibrary(Project& project, bool restore, bool readOnly) :
 
     try
     {
-        // Load all library elements
-        loadElements<Symbol>    (mLibraryPath.getPathTo("sym"),    "symbols",      mSymbols);
-        loadElements<Package>   (mLibraryPath.getPathTo("pkg"),    "packages",     mPackages);
-        loadElements<Component> (mLibraryPath.getPathTo("cmp"),    "components",   mComponents);
-        loadElements<Device>    (mLibraryPath.getPathTo("dev"),    "devices",      mDevices);
+        // Load all library elements concurrently, but add them in the same order as if
+        // they were loaded one after another (so the same error is reported on failure)
+        QList<std::shared_ptr<LoadedElement>> symbols, packages, components, devices;
+        QThreadPool threadPool; // waits for all jobs when leaving this scope
+        startLoadingElements<Symbol>    (mLibraryPath.getPathTo("sym"), threadPool, symbols);
+        startLoadingElements<Package>   (mLibraryPath.getPathTo("pkg"), threadPool, packages);
+        startLoadingElements<Component> (mLibraryPath.getPathTo("cmp"), threadPool, components);
+        startLoadingElements<Device>    (mLibraryPath.getPathTo("dev"), threadPool, devices);
+        threadPool.waitForDone();
+        addLoadedElements<Symbol>       ("symbols",     symbols,    mSymbols);
+        addLoadedElements<Package>      ("packages",    packages,   mPackages);
+        addLoadedElements<Component>    ("components",  components, mComponents);
+        addLoadedElements<Device>       ("devices",     devices,    mDevices);
     }
     catch (Exception &e)
     {
@@ -202,8 +260,8 @@ bool ProjectLibrary::save(bool toOriginal, QStringList& errors) noexcept
  ****************************************************************************************/
 
 template <typename ElementType>
-void ProjectLibrary::loadElements(const FilePath& directory, const QString& type,
-                                  QHash<Uuid, ElementType*>& elementList)
+void ProjectLibrary::startLoadingElements(const FilePath& directory, QThreadPool& threadPool,
+    QList<std::shared_ptr<LoadedElement>>& loadedElements) noexcept
 {
     QDir dir(directory.toStr());
 
@@ -225,16 +283,37 @@ void ProjectLibrary::loadElements(const FilePath& directory, const QString& type
             continue;
         }
 
-        // load the library element --> an exception will be thrown on error
-        ElementType* element = new ElementType(subdirPath, false);
+        // load the library element in the thread pool
+        std::shared_ptr<LoadedElement> loadedElement = std::make_shared<LoadedElement>();
+        loadedElement->directory = subdirPath;
+        loadedElement->load = [](const FilePath& fp) {return new ElementType(fp, false);};
+        threadPool.start(new LoadElementJob(loadedElement, thread()));
+        loadedElements.append(loadedElement);
+    }
+}
+
+template <typename ElementType>
+void ProjectLibrary::addLoadedElements(const QString& type,
+    const QList<std::shared_ptr<LoadedElement>>& loadedElements,
+    QHash<Uuid, ElementType*>& elementList)
+{
+    foreach (const std::shared_ptr<LoadedElement>& loadedElement, loadedElements) {
+        // an exception will be thrown if the element could not be loaded
+        if (loadedElement->error) {
+            loadedElement->error->raise();
+        }
+        Q_ASSERT(loadedElement->element);
+        ElementType* element = static_cast<ElementType*>(loadedElement->element.get());
+        Q_ASSERT(element->thread() == thread()); // moved by the LoadElementJob
 
         if (elementList.contains(element->getUuid())) {
             throw RuntimeError(__FILE__, __LINE__,
                 QString(tr("There are multiple library elements with the same "
-                "UUID in the directory \"%1\"")).arg(subdirPath.toNative()));
+                "UUID in the directory \"%1\"")).arg(loadedElement->directory.toNative()));
         }
 
         elementList.insert(element->getUuid(), element);
+        loadedElement->element.release(); // the element list takes the ownership
     }
 
     qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
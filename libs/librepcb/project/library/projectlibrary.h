@@ -23,6 +23,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/exceptions.h>
@@ -34,6 +35,7 @@
 namespace librepcb {
 
 namespace library {
+class LibraryBaseElement;
 class Symbol;
 class Package;
 class Component;
@@ -100,10 +102,18 @@ class ProjectLibrary final : public QObject
         ProjectLibrary(const ProjectLibrary& other);
         ProjectLibrary& operator=(const ProjectLibrary& rhs);
 
+        // Types
+        struct LoadedElement;
+        class LoadElementJob;
+
         // Private Methods
         template <typename ElementType>
-        void loadElements(const FilePath& directory, const QString& type,
-                          QHash<Uuid, ElementType*>& elementList);
+        void startLoadingElements(const FilePath& directory, QThreadPool& threadPool,
+                                  QList<std::shared_ptr<LoadedElement>>& loadedElements) noexcept;
+        template <typename ElementType>
+        void addLoadedElements(const QString& type,
+                               const QList<std::shared_ptr<LoadedElement>>& loadedElements,
+                               QHash<Uuid, ElementType*>& elementList);
         template <typename ElementType>
         void addElement(ElementType& element,
                         QHash<Uuid, ElementType*>& elementList,
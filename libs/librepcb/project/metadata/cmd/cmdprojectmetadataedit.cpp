@@ -93,6 +93,7 @@ bool CmdProjectMetadataEdit::performExecute()
 
 void CmdProjectMetadataEdit::performUndo()
 {
+    mMetadata.setModified();
     mMetadata.setName(mOldName);
     mMetadata.setAuthor(mOldAuthor);
     mMetadata.setVersion(mOldVersion);
@@ -101,6 +102,7 @@ void CmdProjectMetadataEdit::performUndo()
 
 void CmdProjectMetadataEdit::performRedo()
 {
+    mMetadata.setModified();
     mMetadata.setName(mNewName);
     mMetadata.setAuthor(mNewAuthor);
     mMetadata.setVersion(mNewVersion);
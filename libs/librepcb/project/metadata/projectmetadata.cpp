@@ -119,6 +119,7 @@ void ProjectMetadata::setAttributes(const AttributeList& newAttributes) noexcept
 void ProjectMetadata::updateLastModified() noexcept
 {
     mLastModified = QDateTime::currentDateTime();
+    mFile->setModified();
     emit attributesChanged();
 }
 
@@ -128,6 +129,10 @@ void ProjectMetadata::updateLastModified() noexcept
 
 bool ProjectMetadata::save(bool toOriginal, QStringList& errors) noexcept
 {
+    if (!mFile->isModified(toOriginal)) {
+        return true; // the file is up to date
+    }
+
     bool success = true;
 
     try {
@@ -141,6 +146,26 @@ bool ProjectMetadata::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool ProjectMetadata::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                            QStringList& errors) noexcept
+{
+    if (!mFile->isModified(false)) {
+        return true; // the file is up to date
+    }
+
+    bool success = true;
+
+    try {
+        SExpression doc(serializeToDomElement("librepcb_project_metadata"));
+        snapshots.append(mFile->createSnapshot(doc)); // can throw
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -27,14 +27,13 @@
 #include <librepcb/common/attributes/attribute.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class SmartSExprFile;
-
 namespace project {
 
 class Project;
@@ -150,12 +149,15 @@ class ProjectMetadata final : public QObject, public SerializableObject
         void setAttributes(const AttributeList& newAttributes) noexcept;
 
         /**
-         * @brief Update the last modified datetime
+         * @brief Update the last modified datetime (this modifies the metadata file)
          */
         void updateLastModified() noexcept;
 
         // General Methods
+        void setModified() noexcept {mFile->setModified();}
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
 
         // Operator Overloadings
         ProjectMetadata& operator=(const ProjectMetadata& rhs) = delete;
@@ -20,6 +20,7 @@
 /*****************************************************************************************
  *  Includes
  ****************************************************************************************/
+#include <memory>
 #include <QtCore>
 #include <QPrinter>
 #include <librepcb/common/exceptions.h>
@@ -46,6 +47,58 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Struct Project::ParsedFile
+ ****************************************************************************************/
+
+/**
+ * @brief The result of reading and parsing a schematic or board file in a worker thread
+ */
+struct Project::ParsedFile final
+{
+    FilePath filepath;
+    std::unique_ptr<SmartSExprFile> file;   ///< the opened file (nullptr on error)
+    SExpression root;
+    std::shared_ptr<Exception> error;       ///< nullptr on success
+};
+
+/*****************************************************************************************
+ *  Class Project::ParseFileJob
+ ****************************************************************************************/
+
+/**
+ * @brief Opens and parses one file in the thread pool
+ *
+ * The job does not access the project, so it can run while the project is loaded. The
+ * opened file is passed to the schematic or board afterwards, so every file is opened
+ * only once.
+ */
+class Project::ParseFileJob final : public QRunnable
+{
+    public:
+        ParseFileJob(const std::shared_ptr<ParsedFile>& result, bool restore,
+                     bool readOnly) noexcept :
+            QRunnable(), mResult(result), mRestore(restore), mReadOnly(readOnly) {}
+
+        void run() noexcept override {
+            try {
+                std::unique_ptr<SmartSExprFile> file(new SmartSExprFile(
+                    mResult->filepath, mRestore, mReadOnly)); // can throw
+                mResult->root = file->parseFileAndBuildDomTree(); // can throw
+                mResult->file = std::move(file);
+            } catch (const Exception& e) {
+                mResult->error.reset(e.clone());
+            } catch (...) {
+                mResult->error = std::make_shared<LogicError>(__FILE__, __LINE__);
+            }
+        }
+
+    private:
+        std::shared_ptr<ParsedFile> mResult;
+        bool mRestore;
+        bool mReadOnly;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -53,7 +106,7 @@ namespace project {
 Project::Project(const FilePath& filepath, bool create, bool readOnly) :
     QObject(nullptr), AttributeProvider(), mPath(filepath.getParentDir()),
     mFilepath(filepath), mLock(filepath.getParentDir()), mIsRestored(false),
-    mIsReadOnly(readOnly)
+    mIsReadOnly(readOnly), mIsLoading(true)
 {
     qDebug() << (create ? "create project:" : "open project:") << filepath.toNative();
 
@@ -120,6 +173,11 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
             break;
         }
         case DirectoryLock::LockStatus::StaleLock: {
+            if (mIsReadOnly) {
+                // a read-only project is never written, so just open the last saved state
+                // without asking (read-only mode must work without any user interaction)
+                break;
+            }
             // the application crashed while this project was open! ask the user what to do
             QMessageBox::StandardButton btn = QMessageBox::question(0, tr("Restore Project?"),
                 tr("It seems that the application was crashed while this project was open. "
@@ -169,6 +227,37 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
             Q_ASSERT(mVersionFile->getVersion() <= qApp->getFileFormatVersion());
         }
 
+        // Open the schematic and board list files and start reading and parsing all the
+        // schematic and board files in worker threads. Building the schematics and boards
+        // needs the library and the circuit, which are loaded meanwhile in this thread.
+        // Note: The thread pool waits for all jobs when leaving this scope.
+        QThreadPool threadPool;
+        QList<std::shared_ptr<ParsedFile>> schematicFiles;
+        QList<std::shared_ptr<ParsedFile>> boardFiles;
+        FilePath schematicsFilepath = mPath.getPathTo("core/schematics.lp");
+        FilePath boardsFilepath = mPath.getPathTo("core/boards.lp");
+        if (create) {
+            mSchematicsFile.reset(SmartSExprFile::create(schematicsFilepath));
+            mBoardsFile.reset(SmartSExprFile::create(boardsFilepath));
+        } else {
+            mSchematicsFile.reset(new SmartSExprFile(schematicsFilepath, mIsRestored, mIsReadOnly));
+            SExpression schRoot = mSchematicsFile->parseFileAndBuildDomTree();
+            foreach (const SExpression& node, schRoot.getChildren("schematic")) {
+                std::shared_ptr<ParsedFile> file = std::make_shared<ParsedFile>();
+                file->filepath = FilePath::fromRelative(mPath, node.getValueOfFirstChild<QString>(true));
+                threadPool.start(new ParseFileJob(file, mIsRestored, mIsReadOnly));
+                schematicFiles.append(file);
+            }
+            mBoardsFile.reset(new SmartSExprFile(boardsFilepath, mIsRestored, mIsReadOnly));
+            SExpression brdRoot = mBoardsFile->parseFileAndBuildDomTree();
+            foreach (const SExpression& node, brdRoot.getChildren("board")) {
+                std::shared_ptr<ParsedFile> file = std::make_shared<ParsedFile>();
+                file->filepath = FilePath::fromRelative(mPath, node.getValueOfFirstChild<QString>(true));
+                threadPool.start(new ParseFileJob(file, mIsRestored, mIsReadOnly));
+                boardFiles.append(file);
+            }
+        }
+
         // try to create/open the project file
         if (create) {
             mProjectFile.reset(SmartTextFile::create(mFilepath));
@@ -188,33 +277,27 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
         // Load all schematic layers
         mSchematicLayerProvider.reset(new SchematicLayerProvider(*this));
 
+        // Wait until all files are parsed, then build the schematics and boards in the
+        // order of the list files (errors are reported in that order too)
+        threadPool.waitForDone();
+
         // Load all schematics
-        FilePath schematicsFilepath = mPath.getPathTo("core/schematics.lp");
-        if (create) {
-            mSchematicsFile.reset(SmartSExprFile::create(schematicsFilepath));
-        } else {
-            mSchematicsFile.reset(new SmartSExprFile(schematicsFilepath, mIsRestored, mIsReadOnly));
-            SExpression schRoot = mSchematicsFile->parseFileAndBuildDomTree();
-            foreach (const SExpression& node, schRoot.getChildren("schematic")) {
-                FilePath fp = FilePath::fromRelative(mPath, node.getValueOfFirstChild<QString>(true));
-                Schematic* schematic = new Schematic(*this, fp, mIsRestored, mIsReadOnly);
-                addSchematic(*schematic);
-            }
+        foreach (const std::shared_ptr<ParsedFile>& file, schematicFiles) {
+            if (file->error) file->error->raise();
+            Schematic* schematic = new Schematic(*this, std::move(file->file), file->root);
+            addSchematic(*schematic);
+        }
+        if (!create) {
             qDebug() << mSchematics.count() << "schematics successfully loaded!";
         }
 
         // Load all boards
-        FilePath boardsFilepath = mPath.getPathTo("core/boards.lp");
-        if (create) {
-            mBoardsFile.reset(SmartSExprFile::create(boardsFilepath));
-        } else {
-            mBoardsFile.reset(new SmartSExprFile(boardsFilepath, mIsRestored, mIsReadOnly));
-            SExpression brdRoot = mBoardsFile->parseFileAndBuildDomTree();
-            foreach (const SExpression& node, brdRoot.getChildren("board")) {
-                FilePath fp = FilePath::fromRelative(mPath, node.getValueOfFirstChild<QString>(true));
-                Board* board = new Board(*this, fp, mIsRestored, mIsReadOnly);
-                addBoard(*board);
-            }
+        foreach (const std::shared_ptr<ParsedFile>& file, boardFiles) {
+            if (file->error) file->error->raise();
+            Board* board = new Board(*this, std::move(file->file), file->root);
+            addBoard(*board);
+        }
+        if (!create) {
             qDebug() << mBoards.count() << "boards successfully loaded!";
         }
 
@@ -222,6 +305,7 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) :
         // loaded, so the ERC list now contains all the correct ERC messages.
         // So we can now restore the ignore state of each ERC message from the file.
         mErcMsgList->restoreIgnoreState(); // can throw
+        mIsLoading = false;
 
         if (create) save(true); // write all files to harddisc
     }
@@ -322,6 +406,10 @@ void Project::addSchematic(Schematic& schematic, int newIndex)
 
     schematic.addToProject(); // can throw
     mSchematics.insert(newIndex, &schematic);
+    if (!mIsLoading) {
+        mSchematicsFile->setModified();
+        schematic.setModified(); // the file might have been removed in the meantime
+    }
 
     if (mRemovedSchematics.contains(&schematic)) {
         mRemovedSchematics.removeOne(&schematic);
@@ -347,6 +435,7 @@ void Project::removeSchematic(Schematic& schematic, bool deleteSchematic)
 
     schematic.removeFromProject(); // can throw
     mSchematics.removeAt(index);
+    mSchematicsFile->setModified();
 
     emit schematicRemoved(index);
     emit attributesChanged();
@@ -455,6 +544,10 @@ void Project::addBoard(Board& board, int newIndex)
 
     board.addToProject(); // can throw
     mBoards.insert(newIndex, &board);
+    if (!mIsLoading) {
+        mBoardsFile->setModified();
+        board.setModified(); // the file might have been removed in the meantime
+    }
 
     if (mRemovedBoards.contains(&board)) {
         mRemovedBoards.removeOne(&board);
@@ -475,6 +568,7 @@ void Project::removeBoard(Board& board, bool deleteBoard)
 
     board.removeFromProject(); // can throw
     mBoards.removeAt(index);
+    mBoardsFile->setModified();
 
     emit boardRemoved(index);
     emit attributesChanged();
@@ -503,6 +597,33 @@ void Project::save(bool toOriginal)
     Q_ASSERT(errors.isEmpty());
 }
 
+void Project::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots)
+{
+    QStringList errors;
+
+    if (!createBackupSnapshots(snapshots, errors))
+    {
+        QString msg = QString(tr("The project could not be saved!\n\nError Message:\n%1",
+            "variable count of error messages", errors.count())).arg(errors.join("\n"));
+        throw RuntimeError(__FILE__, __LINE__, msg);
+    }
+    Q_ASSERT(errors.isEmpty());
+}
+
+void Project::setAllFilesModified() noexcept
+{
+    mVersionFile->setModified();
+    mProjectFile->setModified();
+    mSchematicsFile->setModified();
+    mBoardsFile->setModified();
+    mProjectMetadata->setModified();
+    mProjectSettings->setModified();
+    mErcMsgList->setModified();
+    mCircuit->setModified();
+    foreach (Schematic* schematic, mSchematics) {schematic->setModified();}
+    foreach (Board* board, mBoards) {board->setModified();}
+}
+
 /*****************************************************************************************
  *  Inherited from AttributeProvider
  ****************************************************************************************/
@@ -596,10 +717,15 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
         return false;
     }
 
+    // check if any file needs to be saved before the flags are reset by saving them
+    bool contentModified = isContentModified(toOriginal);
+
     // Save version file
     try
     {
-        mVersionFile->save(toOriginal);
+        if (mVersionFile->isModified(toOriginal)) {
+            mVersionFile->save(toOriginal);
+        }
     }
     catch (Exception& e)
     {
@@ -610,7 +736,9 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
     // Save *.lpp project file
     try {
         mProjectFile->setContent("LIBREPCB-PROJECT");
-        mProjectFile->save(toOriginal);
+        if (mProjectFile->isModified(toOriginal)) {
+            mProjectFile->save(toOriginal);
+        }
     } catch (const Exception& e) {
         success = false;
         errors.append(e.getMsg());
@@ -618,11 +746,13 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
 
     // Save core/schematics.lp
     try {
-        SExpression root = SExpression::createList("librepcb_schematics");
-        foreach (Schematic* schematic, mSchematics) {
-            root.appendStringChild("schematic", schematic->getFilePath().toRelative(mPath), true);
+        if (mSchematicsFile->isModified(toOriginal)) {
+            SExpression root = SExpression::createList("librepcb_schematics");
+            foreach (Schematic* schematic, mSchematics) {
+                root.appendStringChild("schematic", schematic->getFilePath().toRelative(mPath), true);
+            }
+            mSchematicsFile->save(root, toOriginal); // can throw
         }
-        mSchematicsFile->save(root, toOriginal); // can throw
     } catch (const Exception& e) {
         success = false;
         errors.append(e.getMsg());
@@ -630,17 +760,23 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
 
     // Save core/boards.lp
     try {
-        SExpression root = SExpression::createList("librepcb_boards");
-        foreach (Board* board, mBoards) {
-            root.appendStringChild("board", board->getFilePath().toRelative(mPath), true);
+        if (mBoardsFile->isModified(toOriginal)) {
+            SExpression root = SExpression::createList("librepcb_boards");
+            foreach (Board* board, mBoards) {
+                root.appendStringChild("board", board->getFilePath().toRelative(mPath), true);
+            }
+            mBoardsFile->save(root, toOriginal); // can throw
         }
-        mBoardsFile->save(root, toOriginal); // can throw
     } catch (const Exception& e) {
         success = false;
         errors.append(e.getMsg());
     }
 
-    // Save metadata
+    // Save metadata (with an updated "last modified datetime" attribute, but only if
+    // any other file is saved too, otherwise the metadata would be rewritten every time)
+    if (contentModified) {
+        mProjectMetadata->updateLastModified();
+    }
     if (!mProjectMetadata->save(toOriginal, errors))
         success = false;
 
@@ -691,12 +827,135 @@ bool Project::save(bool toOriginal, QStringList& errors) noexcept
     if (mIsRestored && success && toOriginal)
         mIsRestored = false;
 
-    // update the "last modified datetime" attribute of the project
-    mProjectMetadata->updateLastModified();
+    return success;
+}
+
+bool Project::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                    QStringList& errors) noexcept
+{
+    bool success = true;
+
+    if (mIsReadOnly)
+    {
+        errors.append(tr("The project was opened in read-only mode."));
+        return false;
+    }
+
+    // check if any file needs to be saved before the flags are reset by saving them
+    bool contentModified = isContentModified(false);
+
+    // The version file, the *.lpp project file and the library elements are cheap to
+    // save, so they are written immediately (like in #save()). All other files are
+    // only captured to be written later.
+
+    // Save version file
+    try {
+        if (mVersionFile->isModified(false)) {
+            mVersionFile->save(false);
+        }
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    // Save *.lpp project file
+    try {
+        mProjectFile->setContent("LIBREPCB-PROJECT");
+        if (mProjectFile->isModified(false)) {
+            mProjectFile->save(false);
+        }
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    // Capture core/schematics.lp
+    try {
+        if (mSchematicsFile->isModified(false)) {
+            SExpression root = SExpression::createList("librepcb_schematics");
+            foreach (Schematic* schematic, mSchematics) {
+                root.appendStringChild("schematic", schematic->getFilePath().toRelative(mPath), true);
+            }
+            snapshots.append(mSchematicsFile->createSnapshot(root)); // can throw
+        }
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    // Capture core/boards.lp
+    try {
+        if (mBoardsFile->isModified(false)) {
+            SExpression root = SExpression::createList("librepcb_boards");
+            foreach (Board* board, mBoards) {
+                root.appendStringChild("board", board->getFilePath().toRelative(mPath), true);
+            }
+            snapshots.append(mBoardsFile->createSnapshot(root)); // can throw
+        }
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    // Capture metadata (with an updated "last modified datetime" attribute, see #save())
+    if (contentModified) {
+        mProjectMetadata->updateLastModified();
+    }
+    if (!mProjectMetadata->createBackupSnapshots(snapshots, errors))
+        success = false;
+
+    // Capture circuit
+    if (!mCircuit->createBackupSnapshots(snapshots, errors))
+        success = false;
+
+    // Capture all removed and added schematics (*.lp files)
+    foreach (Schematic* schematic, mRemovedSchematics + mSchematics)
+    {
+        if (!schematic->createBackupSnapshots(snapshots, errors))
+            success = false;
+    }
+
+    // Capture all removed and added boards (*.lp files)
+    foreach (Board* board, mRemovedBoards + mBoards)
+    {
+        if (!board->createBackupSnapshots(snapshots, errors))
+            success = false;
+    }
+
+    // Save library
+    if (!mProjectLibrary->save(false, errors))
+        success = false;
+
+    // Capture settings
+    if (!mProjectSettings->createBackupSnapshots(snapshots, errors))
+        success = false;
+
+    // Capture ERC messages list
+    if (!mErcMsgList->createBackupSnapshots(snapshots, errors))
+        success = false;
 
     return success;
 }
 
+bool Project::isContentModified(bool original) const noexcept
+{
+    // the metadata file is not checked since the "last modified" attribute is updated
+    // whenever any of these files is saved
+    if (mVersionFile->isModified(original) || mProjectFile->isModified(original) ||
+        mSchematicsFile->isModified(original) || mBoardsFile->isModified(original) ||
+        mProjectSettings->isModified(original) || mErcMsgList->isModified(original) ||
+        mCircuit->isModified(original)) {
+        return true;
+    }
+    foreach (const Schematic* schematic, mSchematics) {
+        if (schematic->isModified(original)) return true;
+    }
+    foreach (const Board* board, mBoards) {
+        if (board->isModified(original)) return true;
+    }
+    return false;
+}
+
 void Project::printSchematicPages(QPrinter& printer, QList<int>& pages)
 {
     if (pages.isEmpty())
@@ -30,6 +30,7 @@
 #include <librepcb/common/version.h>
 #include <librepcb/common/fileio/directorylock.h>
 #include <librepcb/common/attributes/attribute.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -39,7 +40,6 @@ class QPrinter;
 namespace librepcb {
 
 class SmartTextFile;
-class SmartSExprFile;
 class SmartVersionFile;
 
 namespace project {
@@ -90,7 +90,8 @@ class Project final : public QObject, public AttributeProvider
          * @brief The constructor to open an existing project with all its content
          *
          * @param filepath      The filepath to the an existing *.lpp project file
-         * @param readOnly      It true, the project will be opened in read-only mode
+         * @param readOnly      It true, the project will be opened in read-only mode.
+         *                      Then no message boxes are shown while opening it.
          *
          * @throw Exception     If the project could not be opened successfully
          */
@@ -370,6 +371,32 @@ class Project final : public QObject, public AttributeProvider
          */
         void save(bool toOriginal);
 
+        /**
+         * @brief Capture the whole project for writing it to the temporary files later
+         *
+         * This has the same effect as #save() with toOriginal=false, except that the
+         * S-Expressions files are not yet written. Instead, a snapshot of each file is
+         * appended to the passed list. Writing the snapshots does not access the project
+         * anymore, so it can be done in a worker thread (e.g. with SExprSnapshotWriter)
+         * while the project is modified in the main thread.
+         *
+         * @param snapshots     All captured files will be appended to this list
+         *
+         * @note The whole save procedere is described in @ref doc_project_save.
+         *
+         * @throw Exception on error
+         */
+        void createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots);
+
+        /**
+         * @brief Mark all files of the project as modified
+         *
+         * The next call to #save() or #createBackupSnapshots() will then write all
+         * files, even the unchanged ones. This is needed if writing the files has
+         * failed after they were already considered as up to date.
+         */
+        void setAllFilesModified() noexcept;
+
 
         // Inherited from AttributeProvider
         /// @copydoc librepcb::AttributeProvider::getUserDefinedAttributeValue()
@@ -430,6 +457,10 @@ class Project final : public QObject, public AttributeProvider
 
     private:
 
+        // Types
+        struct ParsedFile;
+        class ParseFileJob;
+
         // Private Methods
 
         /**
@@ -454,6 +485,28 @@ class Project final : public QObject, public AttributeProvider
          */
         bool save(bool toOriginal, QStringList& errors) noexcept;
 
+        /**
+         * @brief Capture the project for writing it to the temporary files later
+         *
+         * @param snapshots     All captured files will be appended to this list
+         * @param errors        All errors will be added to this string list (translated)
+         *
+         * @return True on success (then the error list should be empty), false otherwise
+         */
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
+
+        /**
+         * @brief Check if any file of the project (except the metadata) needs to be saved
+         *
+         * Removed schematics and boards are covered by the modified list files.
+         *
+         * @param original  Specifies whether the original or the backup files are checked.
+         *
+         * @return True if at least one file is outdated, false if all are up to date
+         */
+        bool isContentModified(bool original) const noexcept;
+
         /**
          * @brief Print some schematics to a QPrinter (printer or file)
          *
@@ -473,6 +526,7 @@ class Project final : public QObject, public AttributeProvider
         DirectoryLock mLock; ///< Lock for the whole project directory (see @ref doc_project_lock)
         bool mIsRestored; ///< the constructor will set this to true if the project was restored
         bool mIsReadOnly; ///< the constructor will set this to true if the project was opened in read only mode
+        bool mIsLoading; ///< true while the constructor loads the project (nothing is modified yet)
 
         // schematic and board list files
         QScopedPointer<SmartSExprFile> mSchematicsFile; ///< core/schematics.lp
@@ -22,9 +22,11 @@ INCLUDEPATH += \
 
 SOURCES += \
     boards/board.cpp \
+    boards/boardclearanceareacache.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplanesrebuilder.cpp \
     boards/boardselectionquery.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
@@ -121,9 +123,11 @@ SOURCES += \
 
 HEADERS += \
     boards/board.h \
+    boards/boardclearanceareacache.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplanesrebuilder.h \
     boards/boardselectionquery.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
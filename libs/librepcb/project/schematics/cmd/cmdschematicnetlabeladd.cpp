@@ -61,11 +61,13 @@ bool CmdSchematicNetLabelAdd::performExecute()
 
 void CmdSchematicNetLabelAdd::performUndo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.removeNetLabel(*mNetLabel); // can throw
 }
 
 void CmdSchematicNetLabelAdd::performRedo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.addNetLabel(*mNetLabel); // can throw
 }
 
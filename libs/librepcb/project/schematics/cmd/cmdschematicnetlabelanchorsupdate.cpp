@@ -55,11 +55,13 @@ bool CmdSchematicNetLabelAnchorsUpdate::performExecute()
 
 void CmdSchematicNetLabelAnchorsUpdate::performUndo()
 {
+    mSchematic.setModified();
     mSchematic.updateAllNetLabelAnchors();
 }
 
 void CmdSchematicNetLabelAnchorsUpdate::performRedo()
 {
+    mSchematic.setModified();
     mSchematic.updateAllNetLabelAnchors();
 }
 
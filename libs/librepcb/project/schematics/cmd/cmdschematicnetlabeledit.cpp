@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdschematicnetlabeledit.h"
 #include "../items/si_netlabel.h"
+#include "../schematic.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -100,12 +101,14 @@ bool CmdSchematicNetLabelEdit::performExecute()
 
 void CmdSchematicNetLabelEdit::performUndo()
 {
+    mNetLabel.getSchematic().setModified();
     mNetLabel.setPosition(mOldPos);
     mNetLabel.setRotation(mOldRotation);
 }
 
 void CmdSchematicNetLabelEdit::performRedo()
 {
+    mNetLabel.getSchematic().setModified();
     mNetLabel.setPosition(mNewPos);
     mNetLabel.setRotation(mNewRotation);
 }
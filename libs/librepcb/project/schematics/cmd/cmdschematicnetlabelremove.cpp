@@ -59,11 +59,13 @@ bool CmdSchematicNetLabelRemove::performExecute()
 
 void CmdSchematicNetLabelRemove::performUndo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.addNetLabel(mNetLabel); // can throw
 }
 
 void CmdSchematicNetLabelRemove::performRedo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.removeNetLabel(mNetLabel); // can throw
 }
 
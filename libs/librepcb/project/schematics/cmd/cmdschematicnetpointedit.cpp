@@ -24,6 +24,7 @@
 #include "cmdschematicnetpointedit.h"
 #include <librepcb/common/scopeguardlist.h>
 #include "../items/si_netpoint.h"
+#include "../schematic.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -86,6 +87,7 @@ bool CmdSchematicNetPointEdit::performExecute()
 
 void CmdSchematicNetPointEdit::performUndo()
 {
+    mNetPoint.getSchematic().setModified();
     ScopeGuardList sgl;
     mNetPoint.setPinToAttach(mOldSymbolPin); // can throw
     sgl.add([&](){mNetPoint.setPinToAttach(mNewSymbolPin);});
@@ -95,6 +97,7 @@ void CmdSchematicNetPointEdit::performUndo()
 
 void CmdSchematicNetPointEdit::performRedo()
 {
+    mNetPoint.getSchematic().setModified();
     ScopeGuardList sgl;
     mNetPoint.setPinToAttach(mNewSymbolPin); // can throw
     sgl.add([&](){mNetPoint.setPinToAttach(mOldSymbolPin);});
@@ -71,11 +71,13 @@ bool CmdSchematicNetSegmentAdd::performExecute()
 
 void CmdSchematicNetSegmentAdd::performUndo()
 {
+    mSchematic.setModified();
     mSchematic.removeNetSegment(*mNetSegment); // can throw
 }
 
 void CmdSchematicNetSegmentAdd::performRedo()
 {
+    mSchematic.setModified();
     mSchematic.addNetSegment(*mNetSegment); // can throw
 }
 
@@ -25,6 +25,7 @@
 #include "../items/si_netpoint.h"
 #include "../items/si_netline.h"
 #include "../items/si_netsegment.h"
+#include "../schematic.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -93,11 +94,13 @@ bool CmdSchematicNetSegmentAddElements::performExecute()
 
 void CmdSchematicNetSegmentAddElements::performUndo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.removeNetPointsAndNetLines(mNetPoints, mNetLines); // can throw
 }
 
 void CmdSchematicNetSegmentAddElements::performRedo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.addNetPointsAndNetLines(mNetPoints, mNetLines); // can throw
 }
 
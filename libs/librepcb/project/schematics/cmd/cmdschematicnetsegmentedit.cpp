@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdschematicnetsegmentedit.h"
 #include "../items/si_netsegment.h"
+#include "../schematic.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -67,11 +68,13 @@ bool CmdSchematicNetSegmentEdit::performExecute()
 
 void CmdSchematicNetSegmentEdit::performUndo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.setNetSignal(*mOldNetSignal); // can throw
 }
 
 void CmdSchematicNetSegmentEdit::performRedo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.setNetSignal(*mNewNetSignal); // can throw
 }
 
@@ -58,11 +58,13 @@ bool CmdSchematicNetSegmentRemove::performExecute()
 
 void CmdSchematicNetSegmentRemove::performUndo()
 {
+    mSchematic.setModified();
     mSchematic.addNetSegment(mNetSegment); // can throw
 }
 
 void CmdSchematicNetSegmentRemove::performRedo()
 {
+    mSchematic.setModified();
     mSchematic.removeNetSegment(mNetSegment); // can throw
 }
 
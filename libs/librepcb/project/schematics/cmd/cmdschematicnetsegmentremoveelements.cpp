@@ -74,11 +74,13 @@ bool CmdSchematicNetSegmentRemoveElements::performExecute()
 
 void CmdSchematicNetSegmentRemoveElements::performUndo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.addNetPointsAndNetLines(mNetPoints, mNetLines); // can throw
 }
 
 void CmdSchematicNetSegmentRemoveElements::performRedo()
 {
+    mNetSegment.getSchematic().setModified();
     mNetSegment.removeNetPointsAndNetLines(mNetPoints, mNetLines); // can throw
 }
 
@@ -76,11 +76,13 @@ bool CmdSymbolInstanceAdd::performExecute()
 
 void CmdSymbolInstanceAdd::performUndo()
 {
+    mSchematic.setModified();
     mSchematic.removeSymbol(*mSymbolInstance); // can throw
 }
 
 void CmdSymbolInstanceAdd::performRedo()
 {
+    mSchematic.setModified();
     mSchematic.addSymbol(*mSymbolInstance); // can throw
 }
 
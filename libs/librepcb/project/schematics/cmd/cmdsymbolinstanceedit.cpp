@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "cmdsymbolinstanceedit.h"
 #include "../items/si_symbol.h"
+#include "../schematic.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -101,12 +102,14 @@ bool CmdSymbolInstanceEdit::performExecute()
 
 void CmdSymbolInstanceEdit::performUndo()
 {
+    mSymbol.getSchematic().setModified();
     mSymbol.setPosition(mOldPos);
     mSymbol.setRotation(mOldRotation);
 }
 
 void CmdSymbolInstanceEdit::performRedo()
 {
+    mSymbol.getSchematic().setModified();
     mSymbol.setPosition(mNewPos);
     mSymbol.setRotation(mNewRotation);
 }
@@ -58,11 +58,13 @@ bool CmdSymbolInstanceRemove::performExecute()
 
 void CmdSymbolInstanceRemove::performUndo()
 {
+    mSchematic.setModified();
     mSchematic.addSymbol(mSymbol); // can throw
 }
 
 void CmdSymbolInstanceRemove::performRedo()
 {
+    mSchematic.setModified();
     mSchematic.removeSymbol(mSymbol); // can throw
 }
 
@@ -67,9 +67,6 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept
     prepareGeometryChange();
     mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
-    mBoundingRect = QRectF(mLineF.p1(), mLineF.p2()).normalized();
-    mBoundingRect.adjust(-mNetLine.getWidth().toPx()/2, -mNetLine.getWidth().toPx()/2,
-                         mNetLine.getWidth().toPx()/2, mNetLine.getWidth().toPx()/2);
     mShape = QPainterPath();
     mShape.moveTo(mNetLine.getStartPoint().getPosition().toPxQPointF());
     mShape.lineTo(mNetLine.getEndPoint().getPosition().toPxQPointF());
@@ -78,6 +75,9 @@ void SGI_NetLine::updateCacheAndRepaint() noexcept
     Length width = (mNetLine.getWidth() > Length(1270000) ? mNetLine.getWidth() : Length(1270000));
     ps.setWidth(width.toPx());
     mShape = ps.createStroke(mShape);
+    // the grab area is wider than the line, and the scene index (used to find the items
+    // at a position) only knows the bounding rect, so it must contain the whole shape
+    mBoundingRect = mShape.boundingRect();
     update();
 }
 
@@ -75,6 +75,8 @@ SGI_SymbolPin::~SGI_SymbolPin() noexcept
 
 void SGI_SymbolPin::updateCacheAndRepaint() noexcept
 {
+    prepareGeometryChange();
+
     mShape = QPainterPath();
     mShape.setFillRule(Qt::WindingFill);
     mBoundingRect = QRectF();
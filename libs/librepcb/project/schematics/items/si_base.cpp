@@ -79,6 +79,7 @@ void SI_Base::addToSchematic(SGI_Base* item) noexcept
 {
     Q_ASSERT(!mIsAddedToSchematic);
     if (item) {
+        item->setData(sGraphicsItemOwnerDataKey, QVariant::fromValue<QObject*>(this));
         mSchematic.getGraphicsScene().addItem(*item);
     }
     mIsAddedToSchematic = true;
@@ -93,6 +94,15 @@ void SI_Base::removeFromSchematic(SGI_Base* item) noexcept
     mIsAddedToSchematic = false;
 }
 
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+SI_Base* SI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept
+{
+    return qobject_cast<SI_Base*>(item.data(sGraphicsItemOwnerDataKey).value<QObject*>());
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -90,6 +90,21 @@ class SI_Base : public QObject
         // Operator Overloadings
         SI_Base& operator=(const SI_Base& rhs) = delete;
 
+        // Static Methods
+
+        /**
+         * @brief Get the schematic item which has added a graphics item to the schematic
+         *
+         * This allows to use the spatial index of the schematic's graphics scene to look
+         * up schematic items by position.
+         *
+         * @param item  A graphics item of the schematic's graphics scene
+         *
+         * @return The owning schematic item, or nullptr if the graphics item does not
+         *         belong to a schematic item
+         */
+        static SI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 
     protected:
 
@@ -105,6 +120,9 @@ class SI_Base : public QObject
 
     private:
 
+        /// The key of the QGraphicsItem::data() entry which points to the owning item
+        static constexpr int sGraphicsItemOwnerDataKey = 0;
+
         // General Attributes
         bool mIsAddedToSchematic;
         bool mIsSelected;
@@ -457,14 +457,20 @@ void SI_NetSegment::removeFromSchematic()
     sgl.dismiss();
 }
 
-void SI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept
+void SI_NetSegment::setSelectionRect(const QRectF rectPx,
+                                     const QSet<const SI_Base*>& candidates) noexcept
 {
+    // items which are not in the candidates list can't be within the rect, so the
+    // (expensive) check of the grab area can be skipped for them
+    auto isInRect = [&](const SI_Base& item) {
+        return candidates.contains(&item) && item.getGrabAreaScenePx().intersects(rectPx);
+    };
     foreach (SI_NetPoint* netpoint, mNetPoints)
-        netpoint->setSelected(netpoint->getGrabAreaScenePx().intersects(rectPx));
+        netpoint->setSelected(isInRect(*netpoint));
     foreach (SI_NetLine* netline, mNetLines)
-        netline->setSelected(netline->getGrabAreaScenePx().intersects(rectPx));
+        netline->setSelected(isInRect(*netline));
     foreach (SI_NetLabel* netlabel, mNetLabels)
-        netlabel->setSelected(netlabel->getGrabAreaScenePx().intersects(rectPx));
+        netlabel->setSelected(isInRect(*netlabel));
 }
 
 void SI_NetSegment::clearSelection() const noexcept
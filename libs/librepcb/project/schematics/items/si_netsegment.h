@@ -99,7 +99,8 @@ class SI_NetSegment final : public SI_Base, public SerializableObject
         // General Methods
         void addToSchematic() override;
         void removeFromSchematic() override;
-        void setSelectionRect(const QRectF rectPx) noexcept;
+        void setSelectionRect(const QRectF rectPx,
+                              const QSet<const SI_Base*>& candidates) noexcept;
         void clearSelection() const noexcept;
 
         /// @copydoc librepcb::SerializableObject::serialize()
@@ -49,8 +49,9 @@ namespace project {
  *  Constructors / Destructor
  ****************************************************************************************/
 
-Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
-                     bool readOnly, bool create, const QString& newName):
+Schematic::Schematic(Project& project, const FilePath& filepath, bool create,
+                     const QString& newName, std::unique_ptr<SmartSExprFile>&& file,
+                     const SExpression* root) :
     QObject(&project), AttributeProvider(), mProject(project), mFilePath(filepath),
     mIsAddedToProject(false)
 {
@@ -72,24 +73,25 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
         }
         else
         {
-            mFile.reset(new SmartSExprFile(mFilePath, restore, readOnly));
-            SExpression root = mFile->parseFileAndBuildDomTree();
+            Q_ASSERT(file && root);
+            Q_ASSERT(file->getFilepath() == mFilePath);
+            mFile.reset(file.release());
 
             // the schematic seems to be ready to open, so we will create all needed objects
 
-            if (root.getChildByIndex(0).isString()) {
-                mUuid = root.getChildByIndex(0).getValue<Uuid>(true);
+            if (root->getChildByIndex(0).isString()) {
+                mUuid = root->getChildByIndex(0).getValue<Uuid>(true);
             } else {
                 // backward compatibility, remove this some time!
-                mUuid = root.getValueByPath<Uuid>("uuid", true);
+                mUuid = root->getValueByPath<Uuid>("uuid", true);
             }
-            mName = root.getValueByPath<QString>("name", true);
+            mName = root->getValueByPath<QString>("name", true);
 
             // Load grid properties
-            mGridProperties.reset(new GridProperties(root.getChildByPath("grid")));
+            mGridProperties.reset(new GridProperties(root->getChildByPath("grid")));
 
             // Load all symbols
-            foreach (const SExpression& node, root.getChildren("symbol")) {
+            foreach (const SExpression& node, root->getChildren("symbol")) {
                 SI_Symbol* symbol = new SI_Symbol(*this, node);
                 if (getSymbolByUuid(symbol->getUuid())) {
                     throw RuntimeError(__FILE__, __LINE__,
@@ -100,7 +102,7 @@ Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
             }
 
             // Load all netsegments
-            foreach (const SExpression& node, root.getChildren("netsegment")) {
+            foreach (const SExpression& node, root->getChildren("netsegment")) {
                 SI_NetSegment* netsegment = new SI_NetSegment(*this, node);
                 if (getNetSegmentByUuid(netsegment->getUuid())) {
                     throw RuntimeError(__FILE__, __LINE__,
@@ -178,7 +180,17 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
         list.append(netlabel);
     }
     // symbols & pins
-    foreach (SI_Symbol* symbol, mSymbols) {
+    QList<SI_Symbol*> symbols;
+    foreach (SI_Base* item, getItemsInSpatialIndex<SI_Base>(scenePosPx)) {
+        SI_Symbol* symbol = qobject_cast<SI_Symbol*>(item);
+        if (SI_SymbolPin* pin = qobject_cast<SI_SymbolPin*>(item)) {
+            symbol = &pin->getSymbol();
+        }
+        if (symbol && (!symbols.contains(symbol))) {
+            symbols.append(symbol);
+        }
+    }
+    foreach (SI_Symbol* symbol, symbols) {
         foreach (SI_SymbolPin* pin, symbol->getPins()) {
             if (pin->getGrabAreaScenePx().contains(scenePosPx))
                 list.append(pin);
@@ -191,40 +203,47 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_NetPoint*> list;
-    foreach (SI_NetSegment* segment, mNetSegments) {
-        segment->getNetPointsAtScenePos(pos, list);
+    foreach (SI_NetPoint* netpoint, getItemsInSpatialIndex<SI_NetPoint>(scenePosPx)) {
+        if (netpoint->getGrabAreaScenePx().contains(scenePosPx)) {
+            list.append(netpoint);
+        }
     }
     return list;
 }
 
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_NetLine*> list;
-    foreach (SI_NetSegment* segment, mNetSegments) {
-        segment->getNetLinesAtScenePos(pos, list);
+    foreach (SI_NetLine* netline, getItemsInSpatialIndex<SI_NetLine>(scenePosPx)) {
+        if (netline->getGrabAreaScenePx().contains(scenePosPx)) {
+            list.append(netline);
+        }
     }
     return list;
 }
 
 QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_NetLabel*> list;
-    foreach (SI_NetSegment* segment, mNetSegments) {
-        segment->getNetLabelsAtScenePos(pos, list);
+    foreach (SI_NetLabel* netlabel, getItemsInSpatialIndex<SI_NetLabel>(scenePosPx)) {
+        if (netlabel->getGrabAreaScenePx().contains(scenePosPx)) {
+            list.append(netlabel);
+        }
     }
     return list;
 }
 
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const noexcept
 {
+    QPointF scenePosPx = pos.toPxQPointF();
     QList<SI_SymbolPin*> list;
-    foreach (SI_Symbol* symbol, mSymbols)
-    {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
-        {
-            if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-                list.append(pin);
+    foreach (SI_SymbolPin* pin, getItemsInSpatialIndex<SI_SymbolPin>(scenePosPx)) {
+        if (pin->getGrabAreaScenePx().contains(scenePosPx)) {
+            list.append(pin);
         }
     }
     return list;
@@ -237,6 +256,7 @@ QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const noexce
 void Schematic::setGridProperties(const GridProperties& grid) noexcept
 {
     *mGridProperties = grid;
+    setModified();
 }
 
 /*****************************************************************************************
@@ -375,8 +395,10 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept
     {
         if (mIsAddedToProject)
         {
-            SExpression doc(serializeToDomElement("librepcb_schematic"));
-            mFile->save(doc, toOriginal);
+            if (mFile->isModified(toOriginal)) {
+                SExpression doc(serializeToDomElement("librepcb_schematic"));
+                mFile->save(doc, toOriginal);
+            }
         }
         else
         {
@@ -392,6 +414,29 @@ bool Schematic::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool Schematic::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                      QStringList& errors) noexcept
+{
+    bool success = true;
+
+    // capture schematic file
+    try {
+        if (mIsAddedToProject) {
+            if (mFile->isModified(false)) {
+                SExpression doc(serializeToDomElement("librepcb_schematic"));
+                snapshots.append(mFile->createSnapshot(doc)); // can throw
+            }
+        } else {
+            mFile->removeFile(false); // can throw
+        }
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    return success;
+}
+
 void Schematic::showInView(GraphicsView& view) noexcept
 {
     view.setScene(mGraphicsScene.data());
@@ -403,16 +448,23 @@ void Schematic::setSelectionRect(const Point& p1, const Point& p2, bool updateIt
     if (updateItems)
     {
         QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+        // only items found in the spatial index need to be checked exactly
+        QSet<const SI_Base*> candidates;
+        foreach (const SI_Base* item, getItemsInSpatialIndex<SI_Base>(rectPx)) {
+            candidates.insert(item);
+        }
+        auto isInRect = [&](const SI_Base& item) {
+            return candidates.contains(&item) && item.getGrabAreaScenePx().intersects(rectPx);
+        };
         foreach (SI_Symbol* symbol, mSymbols) {
-            bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
+            bool selectSymbol = isInRect(*symbol);
             symbol->setSelected(selectSymbol);
             foreach (SI_SymbolPin* pin, symbol->getPins()) {
-                bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-                pin->setSelected(selectSymbol || selectPin);
+                pin->setSelected(selectSymbol || isInRect(*pin));
             }
         }
         foreach (SI_NetSegment* segment, mNetSegments) {
-            segment->setSelectionRect(rectPx);
+            segment->setSelectionRect(rectPx, candidates);
         }
     }
 }
@@ -469,6 +521,19 @@ QVector<const AttributeProvider*> Schematic::getAttributeProviderParents() const
  *  Private Methods
  ****************************************************************************************/
 
+template <typename T, typename Area>
+QList<T*> Schematic::getItemsInSpatialIndex(const Area& areaPx) const noexcept
+{
+    QList<T*> items;
+    foreach (const QGraphicsItem* graphicsItem, mGraphicsScene->items(areaPx,
+             Qt::IntersectsItemBoundingRect, Qt::DescendingOrder)) {
+        if (T* item = qobject_cast<T*>(SI_Base::fromGraphicsItem(*graphicsItem))) {
+            items.append(item);
+        }
+    }
+    return items;
+}
+
 void Schematic::updateIcon() noexcept
 {
     QRectF source = mGraphicsScene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
@@ -509,7 +574,7 @@ void Schematic::serialize(SExpression& root) const
 Schematic* Schematic::create(Project& project, const FilePath& filepath,
                              const QString& name)
 {
-    return new Schematic(project, filepath, false, false, true, name);
+    return new Schematic(project, filepath, true, name, nullptr, nullptr);
 }
 
 /*****************************************************************************************
@@ -31,6 +31,7 @@
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 #include <librepcb/common/exceptions.h>
 
 /*****************************************************************************************
@@ -41,7 +42,6 @@ namespace librepcb {
 class GridProperties;
 class GraphicsView;
 class GraphicsScene;
-class SmartSExprFile;
 
 namespace project {
 
@@ -107,8 +107,21 @@ class Schematic final : public QObject, public AttributeProvider,
         // Constructors / Destructor
         Schematic() = delete;
         Schematic(const Schematic& other) = delete;
-        Schematic(Project& project, const FilePath& filepath, bool restore, bool readOnly) :
-            Schematic(project, filepath, restore, readOnly, false, QString()) {}
+
+        /**
+         * @brief Load an existing schematic
+         *
+         * @param project   The project of the schematic
+         * @param file      The opened schematic file (the schematic takes the ownership)
+         * @param root      The already parsed content of the file (allows to open and
+         *                  parse the files of several schematics concurrently)
+         *
+         * @throw Exception If the schematic could not be loaded
+         */
+        Schematic(Project& project, std::unique_ptr<SmartSExprFile> file,
+                  const SExpression& root) :
+            Schematic(project, file->getFilepath(), false, QString(), std::move(file),
+                      &root) {}
         ~Schematic() noexcept;
 
         // Getters: General
@@ -144,7 +157,11 @@ class Schematic final : public QObject, public AttributeProvider,
         // General Methods
         void addToProject();
         void removeFromProject();
+        bool isModified(bool original) const noexcept {return mFile->isModified(original);}
+        void setModified() noexcept {mFile->setModified();}
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
         void showInView(GraphicsView& view) noexcept;
         void saveViewSceneRect(const QRectF& rect) noexcept {mViewRect = rect;}
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
@@ -178,11 +195,28 @@ class Schematic final : public QObject, public AttributeProvider,
 
     private:
 
-        Schematic(Project& project, const FilePath& filepath, bool restore,
-                  bool readOnly, bool create, const QString& newName);
+        Schematic(Project& project, const FilePath& filepath, bool create,
+                  const QString& newName, std::unique_ptr<SmartSExprFile>&& file,
+                  const SExpression* root);
         void updateIcon() noexcept;
         bool checkAttributesValidity() const noexcept;
 
+        /**
+         * @brief Get all items of a specific type whose bounding rect touches an area
+         *
+         * The lookup uses the BSP tree index of the graphics scene (which is kept up to
+         * date by Qt when graphics items are moved or changed), so it's much faster than
+         * iterating over all items. The result still needs to be checked against the
+         * exact grab area of the items.
+         *
+         * @tparam T        Type of the schematic items to return
+         * @tparam Area     QPointF or QRectF (scene coordinates in pixels)
+         *
+         * @return The found items, the top most item first
+         */
+        template <typename T, typename Area>
+        QList<T*> getItemsInSpatialIndex(const Area& areaPx) const noexcept;
+
         /// @copydoc librepcb::SerializableObject::serialize()
         void serialize(SExpression& root) const override;
 
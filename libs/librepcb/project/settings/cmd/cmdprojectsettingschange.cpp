@@ -81,12 +81,14 @@ bool CmdProjectSettingsChange::performExecute()
 
 void CmdProjectSettingsChange::performUndo()
 {
+    mSettings.setModified();
     applyOldSettings(); // can throw
     mSettings.triggerSettingsChanged();
 }
 
 void CmdProjectSettingsChange::performRedo()
 {
+    mSettings.setModified();
     applyNewSettings(); // can throw
     mSettings.triggerSettingsChanged();
 }
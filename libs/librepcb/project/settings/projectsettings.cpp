@@ -105,6 +105,10 @@ void ProjectSettings::triggerSettingsChanged() noexcept
 
 bool ProjectSettings::save(bool toOriginal, QStringList& errors) noexcept
 {
+    if (!mFile->isModified(toOriginal)) {
+        return true; // the file is up to date
+    }
+
     bool success = true;
 
     // Save "core/settings.lp"
@@ -122,6 +126,26 @@ bool ProjectSettings::save(bool toOriginal, QStringList& errors) noexcept
     return success;
 }
 
+bool ProjectSettings::createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                            QStringList& errors) noexcept
+{
+    if (!mFile->isModified(false)) {
+        return true; // the file is up to date
+    }
+
+    bool success = true;
+
+    try {
+        SExpression doc(serializeToDomElement("librepcb_project_settings"));
+        snapshots.append(mFile->createSnapshot(doc)); // can throw
+    } catch (const Exception& e) {
+        success = false;
+        errors.append(e.getMsg());
+    }
+
+    return success;
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
@@ -26,14 +26,13 @@
 #include <QtCore>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class SmartSExprFile;
-
 namespace project {
 
 class Project;
@@ -72,7 +71,11 @@ class ProjectSettings final : public QObject, public SerializableObject
         // General Methods
         void restoreDefaults() noexcept;
         void triggerSettingsChanged() noexcept;
+        bool isModified(bool original) const noexcept {return mFile->isModified(original);}
+        void setModified() noexcept {mFile->setModified();}
         bool save(bool toOriginal, QStringList& errors) noexcept;
+        bool createBackupSnapshots(QList<SmartSExprFile::Snapshot>& snapshots,
+                                   QStringList& errors) noexcept;
 
 
     signals:
@@ -174,6 +174,16 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
             mUi->statusbar, &StatusBar::hideProgressBar, Qt::QueuedConnection);
     connect(&mProjectEditor.getWorkspace().getLibraryDb(), &workspace::WorkspaceLibraryDb::scanProgressUpdate,
             mUi->statusbar, &StatusBar::setProgressBarPercent, Qt::QueuedConnection);
+    connect(&mProjectEditor, &ProjectEditor::autosaveProgressUpdate, this, [this](int percent){
+        mUi->statusbar->showMessage(tr("Saving backup (%1%)...").arg(percent));
+    });
+    connect(&mProjectEditor, &ProjectEditor::autosaveFinished, this, [this](bool success){
+        if (success) {
+            mUi->statusbar->clearMessage();
+        } else {
+            mUi->statusbar->showMessage(tr("Failed to save the backup!"), 5000);
+        }
+    });
     connect(mGraphicsView, &GraphicsView::cursorScenePositionChanged,
             mUi->statusbar, &StatusBar::setAbsoluteCursorPosition);
 
@@ -480,7 +490,7 @@ void BoardEditor::on_actionModifyDesignRules_triggered()
 void BoardEditor::on_actionRebuildPlanes_triggered()
 {
     Board* board = getActiveBoard();
-    if (board) board->rebuildAllPlanes();
+    if (board) board->rebuildAllPlanesInBackground();
 }
 
 void BoardEditor::on_tabBar_currentChanged(int index)
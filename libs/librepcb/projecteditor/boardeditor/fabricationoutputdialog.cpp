@@ -79,10 +79,18 @@ void FabricationOutputDialog::on_btnGenerate_clicked()
 
         FilePath filepath(mUi->edtOutputDirPath->text());
         BoardGerberExport grbExport(mBoard, filepath);
+        grbExport.setDrillRouteOptimization(mUi->cbxOptimizeDrillRoute->isChecked());
+        connect(&grbExport, &BoardGerberExport::layerExported,
+                this, &FabricationOutputDialog::layerExported);
+        mUi->progressBar->setValue(0);
+        mUi->lblProgress->clear();
         grbExport.exportAllLayers();
+        mUi->lblProgress->setText(tr("Finished. Travel distance of the drill head: %1 mm")
+                                  .arg(grbExport.getDrillTravelDistance().toMmString()));
     }
     catch (Exception& e)
     {
+        mUi->lblProgress->setText(tr("Failed to generate the files."));
         QMessageBox::warning(this, tr("Error"), e.getMsg());
     }
 }
@@ -97,6 +105,17 @@ void FabricationOutputDialog::on_btnBrowseOutputDir_clicked()
     }
 }
 
+void FabricationOutputDialog::layerExported(const FilePath& filepath, int exportedLayers,
+                                            int totalLayers) noexcept
+{
+    // the event loop is blocked during the export, so repaint the widgets immediately
+    mUi->progressBar->setMaximum(totalLayers);
+    mUi->progressBar->setValue(exportedLayers);
+    mUi->progressBar->repaint();
+    mUi->lblProgress->setText(tr("Exported %1").arg(filepath.getFilename()));
+    mUi->lblProgress->repaint();
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcb/common/fileio/filepath.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -69,6 +70,8 @@ class FabricationOutputDialog final : public QDialog
         void on_btnSelectDir_clicked();
         void on_btnGenerate_clicked();
         void on_btnBrowseOutputDir_clicked();
+        void layerExported(const FilePath& filepath, int exportedLayers,
+                           int totalLayers) noexcept;
 
 
     private:
@@ -63,7 +63,7 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace, Project&
                                        QWidget* parent) :
     QDialog(parent), mWorkspace(workspace), mProject(project),
     mUi(new Ui::AddComponentDialog), mComponentPreviewScene(nullptr),
-    mDevicePreviewScene(nullptr), mCategoryTreeModel(nullptr),
+    mDevicePreviewScene(nullptr), mCategoryTreeModel(nullptr), mCurrentSearchId(-1),
     mSelectedComponent(nullptr), mSelectedSymbVar(nullptr), mSelectedDevice(nullptr),
     mSelectedPackage(nullptr), mPreviewFootprintGraphicsItem(nullptr)
 {
@@ -96,6 +96,12 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace, Project&
     mGraphicsLayerProvider.reset(new DefaultGraphicsLayerProvider());
 
     const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
+    mSearchWorker.reset(new ComponentSearchWorker(mWorkspace.getLibraryDb(), localeOrder));
+    connect(mSearchWorker.data(), &ComponentSearchWorker::resultsAvailable,
+            this, &AddComponentDialog::searchResultsAvailable, Qt::QueuedConnection);
+    connect(mSearchWorker.data(), &ComponentSearchWorker::searchFailed,
+            this, &AddComponentDialog::searchFailed, Qt::QueuedConnection);
+
     mCategoryTreeModel = new workspace::ComponentCategoryTreeModel(mWorkspace.getLibraryDb(), localeOrder);
     mUi->treeCategories->setModel(mCategoryTreeModel);
     connect(mUi->treeCategories->selectionModel(), &QItemSelectionModel::currentChanged,
@@ -104,6 +110,7 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace, Project&
 
 AddComponentDialog::~AddComponentDialog() noexcept
 {
+    mSearchWorker.reset(); // stop the worker thread before deleting anything else
     delete mPreviewFootprintGraphicsItem;       mPreviewFootprintGraphicsItem = nullptr;
     qDeleteAll(mPreviewSymbolGraphicsItems);    mPreviewSymbolGraphicsItems.clear();
     delete mSelectedPackage;                    mSelectedPackage = nullptr;
@@ -158,10 +165,40 @@ void AddComponentDialog::searchEditTextChanged(const QString& text) noexcept
             searchComponents(text.trimmed());
         }
     } catch (const Exception& e) {
-        QMessageBox::critical(this, tr("Error"), e.getMsg());
+        showSearchError(e.getMsg()); // don't interrupt typing with a message box
+    }
+}
+
+void AddComponentDialog::searchResultsAvailable(int searchId,
+    QList<librepcb::project::editor::ComponentSearchResult> results) noexcept
+{
+    if (searchId != mCurrentSearchId) return; // results of an outdated search
+
+    // results are ordered by relevance, so just append them to the tree
+    foreach (const ComponentSearchResult& cmp, results) {
+        QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
+        cmpItem->setText(0, cmp.name);
+        cmpItem->setData(0, Qt::UserRole, cmp.filepath.toStr());
+        foreach (const ComponentSearchResult::Device& dev, cmp.devices) {
+            QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
+            devItem->setText(0, dev.name);
+            devItem->setData(0, Qt::UserRole, dev.filepath.toStr());
+            if (!dev.packageName.isNull()) {
+                devItem->setText(1, dev.packageName);
+                devItem->setTextAlignment(1, Qt::AlignRight);
+            }
+        }
+        cmpItem->setText(1, QString("[%1]").arg(cmp.devices.count()));
+        cmpItem->setTextAlignment(1, Qt::AlignRight);
     }
 }
 
+void AddComponentDialog::searchFailed(int searchId, QString errorMsg) noexcept
+{
+    if (searchId != mCurrentSearchId) return; // error of an outdated search
+    showSearchError(errorMsg); // don't interrupt typing with a message box
+}
+
 void AddComponentDialog::treeCategories_currentItemChanged(const QModelIndex& current,
                                                            const QModelIndex& previous) noexcept
 {
@@ -228,55 +265,31 @@ void AddComponentDialog::searchComponents(const QString& input)
     setSelectedComponent(nullptr);
     mUi->treeComponents->clear();
 
-    if (input.length() > 1) { // avoid freeze on entering first character due to huge result
-        const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
-        QSet<Uuid> components = mWorkspace.getLibraryDb().getComponentsBySearchKeyword(input);
-        foreach (const Uuid& cmpUuid, components) {
-            // component
-            FilePath cmpFp = mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);
-            if (!cmpFp.isValid()) continue;
-            QString cmpName;
-            mWorkspace.getLibraryDb().getElementTranslations<library::Component>(cmpFp, localeOrder, &cmpName);
-            QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
-            cmpItem->setText(0, cmpName);
-            cmpItem->setData(0, Qt::UserRole, cmpFp.toStr());
-            // devices
-            QSet<Uuid> devices = mWorkspace.getLibraryDb().getDevicesOfComponent(cmpUuid);
-            foreach (const Uuid& devUuid, devices) {
-                try {
-                    FilePath devFp = mWorkspace.getLibraryDb().getLatestDevice(devUuid);
-                    if (!devFp.isValid()) continue;
-                    QString devName;
-                    mWorkspace.getLibraryDb().getElementTranslations<library::Device>(devFp, localeOrder, &devName);
-                    QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
-                    devItem->setText(0, devName);
-                    devItem->setData(0, Qt::UserRole, devFp.toStr());
-                    // package
-                    Uuid pkgUuid;
-                    mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid);
-                    if (!pkgUuid.isNull()) {
-                        FilePath pkgFp = mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);
-                        if (pkgFp.isValid()) {
-                            QString pkgName;
-                            mWorkspace.getLibraryDb().getElementTranslations<library::Package>(pkgFp, localeOrder, &pkgName);
-                            devItem->setText(1, pkgName);
-                            devItem->setTextAlignment(1, Qt::AlignRight);
-                        }
-                    }
-                } catch (const Exception& e) {
-                    // what could we do here?
-                }
-            }
-            cmpItem->setText(1, QString("[%1]").arg(devices.count()));
-            cmpItem->setTextAlignment(1, Qt::AlignRight);
-        }
+    // the search runs in the worker thread, results are added in searchResultsAvailable()
+    if (input.length() > 1) { // avoid huge result on entering the first character
+        mCurrentSearchId = mSearchWorker->startSearch(input);
+    } else {
+        mSearchWorker->cancelSearch();
+        mCurrentSearchId = -1;
     }
+}
 
-    mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
+void AddComponentDialog::showSearchError(const QString& errorMsg) noexcept
+{
+    // show the error in place of the results, since the user is probably still typing
+    setSelectedComponent(nullptr);
+    mUi->treeComponents->clear();
+    QTreeWidgetItem* item = new QTreeWidgetItem(mUi->treeComponents);
+    item->setText(0, tr("Search failed: %1").arg(errorMsg));
+    item->setToolTip(0, errorMsg);
+    item->setForeground(0, QBrush(Qt::red));
+    item->setFlags(Qt::NoItemFlags);
 }
 
 void AddComponentDialog::setSelectedCategory(const Uuid& categoryUuid)
 {
+    mSearchWorker->cancelSearch();
+    mCurrentSearchId = -1;
     setSelectedComponent(nullptr);
     mUi->treeComponents->clear();
 
@@ -29,6 +29,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
+#include "componentsearchworker.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -94,6 +95,8 @@ class AddComponentDialog final : public QDialog
 
     private slots:
         void searchEditTextChanged(const QString& text) noexcept;
+        void searchResultsAvailable(int searchId, QList<librepcb::project::editor::ComponentSearchResult> results) noexcept;
+        void searchFailed(int searchId, QString errorMsg) noexcept;
         void treeCategories_currentItemChanged(const QModelIndex& current,
                                                const QModelIndex& previous) noexcept;
         void treeComponents_currentItemChanged(QTreeWidgetItem *current,
@@ -106,6 +109,7 @@ class AddComponentDialog final : public QDialog
 
         // Private Methods
         void searchComponents(const QString& input);
+        void showSearchError(const QString& errorMsg) noexcept;
         void setSelectedCategory(const Uuid& categoryUuid);
         void setSelectedComponent(const library::Component* cmp);
         void setSelectedSymbVar(const library::ComponentSymbolVariant* symbVar);
@@ -121,6 +125,8 @@ class AddComponentDialog final : public QDialog
         GraphicsScene* mDevicePreviewScene;
         QScopedPointer<DefaultGraphicsLayerProvider> mGraphicsLayerProvider;
         workspace::ComponentCategoryTreeModel* mCategoryTreeModel;
+        QScopedPointer<ComponentSearchWorker> mSearchWorker;
+        int mCurrentSearchId;   ///< ID of the search whose results are displayed
 
 
         // Attributes
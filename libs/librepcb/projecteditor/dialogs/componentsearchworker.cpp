@@ -0,0 +1,186 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "componentsearchworker.h"
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/workspace/library/workspacelibrarydb.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ComponentSearchWorker::ComponentSearchWorker(const workspace::WorkspaceLibraryDb& db,
+                                             const QStringList& localeOrder) noexcept :
+    QThread(nullptr), mDb(db), mLocaleOrder(localeOrder), mSearchId(0),
+    mSearchPending(false), mAbort(false)
+{
+    qRegisterMetaType<ComponentSearchResult>();
+    qRegisterMetaType<QList<ComponentSearchResult>>();
+}
+
+ComponentSearchWorker::~ComponentSearchWorker() noexcept
+{
+    {
+        QMutexLocker locker(&mMutex);
+        mAbort = true;
+        mCondition.wakeAll();
+    }
+    if (!wait(2000)) {
+        qWarning() << "Could not abort the component search worker thread!";
+        terminate();
+        if (!wait(2000)) {
+            qCritical() << "Could not terminate the component search worker thread!";
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+int ComponentSearchWorker::startSearch(const QString& keyword) noexcept
+{
+    QMutexLocker locker(&mMutex);
+    mKeyword = keyword;
+    mSearchPending = true;
+    int searchId = ++mSearchId;
+    mCondition.wakeAll();
+    locker.unlock();
+
+    if (!isRunning()) {
+        start();
+    }
+    return searchId;
+}
+
+void ComponentSearchWorker::cancelSearch() noexcept
+{
+    QMutexLocker locker(&mMutex);
+    ++mSearchId; // makes the running search obsolete
+    mSearchPending = false;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void ComponentSearchWorker::run() noexcept
+{
+    forever {
+        // wait for the next search request (only the latest one is executed)
+        QMutexLocker locker(&mMutex);
+        while ((!mSearchPending) && (!mAbort)) {
+            mCondition.wait(&mMutex);
+        }
+        if (mAbort) break;
+        int searchId = mSearchId;
+        QString keyword = mKeyword;
+        mSearchPending = false;
+        locker.unlock();
+
+        try {
+            search(searchId, keyword);
+            if (!isObsolete(searchId)) {
+                emit searchFinished(searchId);
+            }
+        } catch (const Exception& e) {
+            emit searchFailed(searchId, e.getMsg());
+        }
+    }
+}
+
+void ComponentSearchWorker::search(int searchId, const QString& keyword)
+{
+    if (isObsolete(searchId)) return; // cancelled before the (expensive) query started
+
+    // limit the number of results, since short keywords may match most of the library
+    // and the query itself cannot be interrupted (the user can refine the keyword)
+    QList<ComponentSearchResult> chunk;
+    QList<Uuid> components = mDb.getComponentsBySearchKeyword(keyword, sMaxResults); // can throw
+    foreach (const Uuid& cmpUuid, components) {
+        if (isObsolete(searchId)) return; // cancelled by a newer search
+
+        // component
+        ComponentSearchResult cmp;
+        cmp.filepath = mDb.getLatestComponent(cmpUuid);
+        if (!cmp.filepath.isValid()) continue;
+        mDb.getElementTranslations<library::Component>(cmp.filepath, mLocaleOrder, &cmp.name);
+
+        // devices
+        foreach (const Uuid& devUuid, mDb.getDevicesOfComponent(cmpUuid)) {
+            try {
+                ComponentSearchResult::Device dev;
+                dev.filepath = mDb.getLatestDevice(devUuid);
+                if (!dev.filepath.isValid()) continue;
+                mDb.getElementTranslations<library::Device>(dev.filepath, mLocaleOrder, &dev.name);
+                // package
+                Uuid pkgUuid;
+                mDb.getDeviceMetadata(dev.filepath, &pkgUuid);
+                if (!pkgUuid.isNull()) {
+                    FilePath pkgFp = mDb.getLatestPackage(pkgUuid);
+                    if (pkgFp.isValid()) {
+                        mDb.getElementTranslations<library::Package>(pkgFp, mLocaleOrder, &dev.packageName);
+                    }
+                }
+                cmp.devices.append(dev);
+            } catch (const Exception& e) {
+                // what could we do here?
+            }
+        }
+
+        // emit results in chunks to show the first hits as soon as possible
+        chunk.append(cmp);
+        if (chunk.count() >= sChunkSize) {
+            emit resultsAvailable(searchId, chunk);
+            chunk.clear();
+        }
+    }
+    if (!chunk.isEmpty()) {
+        emit resultsAvailable(searchId, chunk);
+    }
+}
+
+bool ComponentSearchWorker::isObsolete(int searchId) const noexcept
+{
+    QMutexLocker locker(&mMutex);
+    return mAbort || (searchId != mSearchId);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_COMPONENTSEARCHWORKER_H
+#define LIBREPCB_PROJECT_COMPONENTSEARCHWORKER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcb/common/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace workspace {
+class WorkspaceLibraryDb;
+}
+
+namespace project {
+namespace editor {
+
+/*****************************************************************************************
+ *  Struct ComponentSearchResult
+ ****************************************************************************************/
+
+/**
+ * @brief A component found by the ComponentSearchWorker, together with its devices
+ */
+struct ComponentSearchResult {
+    struct Device {
+        FilePath filepath;
+        QString name;
+        QString packageName;
+    };
+    FilePath filepath;
+    QString name;
+    QList<Device> devices;
+};
+
+/*****************************************************************************************
+ *  Class ComponentSearchWorker
+ ****************************************************************************************/
+
+/**
+ * @brief The ComponentSearchWorker class searches components in the workspace library
+ *        in a separate thread
+ *
+ * Every call to #startSearch() cancels the currently running search (if any) and
+ * starts a new one, so the worker never processes outdated keywords. If several
+ * searches are requested while one is running, only the last one is executed.
+ *
+ * The results are emitted in small chunks (#resultsAvailable()) as soon as they are
+ * resolved, so the first hits can be displayed while the search is still running.
+ */
+class ComponentSearchWorker final : public QThread
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        ComponentSearchWorker() = delete;
+        ComponentSearchWorker(const ComponentSearchWorker& other) = delete;
+        ComponentSearchWorker(const workspace::WorkspaceLibraryDb& db,
+                              const QStringList& localeOrder) noexcept;
+        ~ComponentSearchWorker() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Start a new search (and cancel the running one)
+         *
+         * @param keyword   The search term
+         *
+         * @return The ID of the new search, which is passed to all emitted signals
+         */
+        int startSearch(const QString& keyword) noexcept;
+
+        /**
+         * @brief Cancel the running search (if any)
+         */
+        void cancelSearch() noexcept;
+
+        // Operator Overloadings
+        ComponentSearchWorker& operator=(const ComponentSearchWorker& rhs) = delete;
+
+
+    signals:
+
+        void resultsAvailable(int searchId, QList<librepcb::project::editor::ComponentSearchResult> results);
+        void searchFinished(int searchId);
+        void searchFailed(int searchId, QString errorMsg);
+
+
+    private: // Methods
+
+        void run() noexcept override;
+        void search(int searchId, const QString& keyword);
+        bool isObsolete(int searchId) const noexcept;
+
+
+    private: // Data
+
+        const workspace::WorkspaceLibraryDb& mDb;
+        QStringList mLocaleOrder;
+
+        // protected by mMutex
+        mutable QMutex mMutex;
+        QWaitCondition mCondition;
+        QString mKeyword;       ///< keyword of the latest requested search
+        int mSearchId;          ///< ID of the latest requested search
+        bool mSearchPending;    ///< whether the latest requested search is not started yet
+        bool mAbort;
+
+        // Constants
+        static const int sChunkSize = 10;   ///< number of components per emitted chunk
+        static const int sMaxResults = 200; ///< maximum number of components per search
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace editor
+} // namespace project
+} // namespace librepcb
+
+Q_DECLARE_METATYPE(librepcb::project::editor::ComponentSearchResult)
+
+#endif // LIBREPCB_PROJECT_COMPONENTSEARCHWORKER_H
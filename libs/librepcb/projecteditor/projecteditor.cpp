@@ -23,6 +23,7 @@
 #include <QtCore>
 #include "projecteditor.h"
 #include <librepcb/common/undostack.h>
+#include <librepcb/common/fileio/sexprsnapshotwriter.h>
 #include <librepcb/workspace/workspace.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/project/project.h>
@@ -75,8 +76,9 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
 
 ProjectEditor::~ProjectEditor() noexcept
 {
-    // stop the autosave timer
+    // stop the autosave timer and wait until the last backup is written completely
     mAutoSaveTimer.stop();
+    mAutosaveWriter.reset();
 
     // abort all active commands!
     mSchematicEditor->abortAllCommands();
@@ -157,6 +159,11 @@ void ProjectEditor::execNetClassesEditorDialog(QWidget* parent) noexcept
 
 bool ProjectEditor::saveProject() noexcept
 {
+    // a running backup must not interfere with the temporary files written below
+    if (mAutosaveWriter) {
+        mAutosaveWriter->wait();
+    }
+
     try
     {
         // step 1: save whole project to temporary files
@@ -184,10 +191,12 @@ bool ProjectEditor::autosaveProject() noexcept
     if ((!mProject.isRestored()) && (mUndoStack->isClean()))
         return false; // do not save if there are no changes
 
-    if (mUndoStack->isCommandGroupActive())
+    if ((mUndoStack->isCommandGroupActive()) ||
+        (mAutosaveWriter && mAutosaveWriter->isRunning()))
     {
-        // the user is executing a command at the moment, so we should not save now,
-        // try it a few seconds later instead...
+        // the user is executing a command at the moment (or the last backup is not yet
+        // written completely), so we should not save now, try it a few seconds later
+        // instead...
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
         QTimer::singleShot(10000, this, &ProjectEditor::autosaveProject);
 #else
@@ -199,12 +208,33 @@ bool ProjectEditor::autosaveProject() noexcept
     try
     {
         qDebug() << "Begin autosaving the project to temporary files...";
-        mProject.save(false);
-        qDebug() << "Project successfully autosaved";
+        QList<SmartSExprFile::Snapshot> snapshots;
+        mProject.createBackupSnapshots(snapshots); // can throw
+
+        // write the temporary files in a separate thread
+        mAutosaveWriter.reset(new SExprSnapshotWriter(snapshots));
+        connect(mAutosaveWriter.data(), &SExprSnapshotWriter::progressUpdate,
+                this, &ProjectEditor::autosaveProgressUpdate, Qt::QueuedConnection);
+        connect(mAutosaveWriter.data(), &SExprSnapshotWriter::succeeded,
+                this, [this](int fileCount){
+                    qDebug() << "Project successfully autosaved," << fileCount << "files written";
+                    emit autosaveFinished(true);
+                }, Qt::QueuedConnection);
+        connect(mAutosaveWriter.data(), &SExprSnapshotWriter::failed,
+                this, [this](const QString& errorMsg){
+                    qWarning() << "Could not autosave the project:" << errorMsg;
+                    mProject.setAllFilesModified(); // write all files again next time
+                    emit autosaveFinished(false);
+                }, Qt::QueuedConnection);
+        emit autosaveProgressUpdate(0);
+        mAutosaveWriter->start();
         return true;
     }
     catch (Exception& exc)
     {
+        qWarning() << "Could not autosave the project:" << exc.getMsg();
+        mProject.setAllFilesModified(); // write all files again next time
+        emit autosaveFinished(false);
         return false;
     }
 }
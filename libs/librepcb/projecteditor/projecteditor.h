@@ -37,6 +37,7 @@ class QMainWindow;
 namespace librepcb {
 
 class UndoStack;
+class SExprSnapshotWriter;
 
 namespace workspace {
 class Workspace;
@@ -167,9 +168,13 @@ class ProjectEditor final : public QObject
         /**
          * @brief Make a automatic backup of the project (save to temporary files)
          *
+         * The project is only captured in the main thread, the temporary files are then
+         * written in a separate thread to not block the user interface. The progress is
+         * reported with the signals #autosaveProgressUpdate() and #autosaveFinished().
+         *
          * @note The whole save procedere is described in @ref doc_project_save.
          *
-         * @return true on success, false on failure
+         * @return true if the backup was started, false on failure
          */
         bool autosaveProject() noexcept;
 
@@ -202,6 +207,8 @@ class ProjectEditor final : public QObject
 
         void showControlPanelClicked();
         void projectEditorClosed();
+        void autosaveProgressUpdate(int percent);
+        void autosaveFinished(bool success);
 
 
     private: // Methods
@@ -214,6 +221,7 @@ class ProjectEditor final : public QObject
         workspace::Workspace& mWorkspace;
         Project& mProject;
         QTimer mAutoSaveTimer; ///< the timer for the periodically automatic saving functionality (see also @ref doc_project_save)
+        QScopedPointer<SExprSnapshotWriter> mAutosaveWriter; ///< writes the temporary files of the last automatic backup
         UndoStack* mUndoStack; ///< See @ref doc_project_undostack
         SchematicEditor* mSchematicEditor; ///< The schematic editor (GUI)
         BoardEditor* mBoardEditor; ///< The board editor (GUI)
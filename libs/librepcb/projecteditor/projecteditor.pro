@@ -62,6 +62,7 @@ SOURCES += \
     cmd/cmdrotateselectedboarditems.cpp \
     cmd/cmdrotateselectedschematicitems.cpp \
     dialogs/addcomponentdialog.cpp \
+    dialogs/componentsearchworker.cpp \
     dialogs/editnetclassesdialog.cpp \
     dialogs/projectpropertieseditordialog.cpp \
     dialogs/projectsettingsdialog.cpp \
@@ -125,6 +126,7 @@ HEADERS += \
     cmd/cmdrotateselectedboarditems.h \
     cmd/cmdrotateselectedschematicitems.h \
     dialogs/addcomponentdialog.h \
+    dialogs/componentsearchworker.h \
     dialogs/editnetclassesdialog.h \
     dialogs/projectpropertieseditordialog.h \
     dialogs/projectsettingsdialog.h \
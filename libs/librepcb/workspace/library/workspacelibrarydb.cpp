@@ -50,12 +50,13 @@ using namespace library;
  ****************************************************************************************/
 
 WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws):
-    QObject(nullptr), mWorkspace(ws)
+    QObject(nullptr), mWorkspace(ws),
+    mFilePath(ws.getLibrariesPath().getPathTo("cache.sqlite")), mHasSearchIndex(false)
 {
     qDebug("Load workspace library database...");
 
     // open SQLite database
-    FilePath dbFilePath = ws.getLibrariesPath().getPathTo("cache.sqlite");
+    FilePath dbFilePath = mFilePath;
     mDb.reset(new SQLiteDatabase(dbFilePath)); // can throw
 
     // if the db has an old version, just remove the whole db and create a new one
@@ -68,6 +69,7 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws):
         createAllTables(); // can throw
         setDbVersion(sCurrentDbVersion); // can throw
     }
+    mHasSearchIndex = mDb->isExistingTable("search_index"); // can throw
 
     // create library scanner object
     mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace));
@@ -243,10 +245,10 @@ void WorkspaceLibraryDb::getElementTranslations<Device>(const FilePath& elemDir,
 
 void WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir, Uuid* pkgUuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT package_uuid FROM devices WHERE filepath = :filepath");
     query.bindValue(":filepath", devDir.toRelative(mWorkspace.getLibrariesPath()));
-    mDb->exec(query);
+    getDb().exec(query);
 
     Uuid uuid = query.first() ? Uuid(query.value(0).toString()) : Uuid();
     if (uuid.isNull()) {
@@ -303,10 +305,10 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesByCategory(const Uuid& category) const
 
 QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(const Uuid& component) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT uuid FROM devices WHERE component_uuid = :uuid");
     query.bindValue(":uuid", component.toStr());
-    mDb->exec(query);
+    getDb().exec(query);
 
     QSet<Uuid> elements;
     while (query.next()) {
@@ -320,30 +322,55 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(const Uuid& component) cons
     return elements;
 }
 
-QSet<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeyword(const QString& keyword) const
-{
-    QSqlQuery query = mDb->prepareQuery(
-        "SELECT components.uuid FROM components, components_tr, devices, devices_tr "
-        "ON components.id=components_tr.component_id "
-        "AND devices.id=devices_tr.device_id "
-        "AND devices.component_uuid=components.uuid "
-        "WHERE components_tr.name LIKE :keyword "
-        "OR components_tr.keywords LIKE :keyword "
-        "OR devices_tr.name LIKE :keyword "
-        "OR devices_tr.keywords LIKE :keyword ");
-    query.bindValue(":keyword", "%" + keyword + "%");
-    mDb->exec(query);
-
-    QSet<Uuid> elements;
-    while (query.next()) {
-        Uuid uuid(query.value(0).toString());
-        if (!uuid.isNull()) {
-            elements.insert(uuid);
-        } else {
-            throw LogicError(__FILE__, __LINE__);
-        }
+QList<Uuid> WorkspaceLibraryDb::getComponentsBySearchKeyword(const QString& keyword,
+                                                             int limit) const
+{
+    if (mHasSearchIndex) {
+        QString ftsQuery = toSearchIndexQuery(keyword);
+        if (ftsQuery.isEmpty()) return QList<Uuid>();
+        QSqlQuery query = getDb().prepareQuery(
+            "SELECT uuid FROM ("
+            "SELECT components.uuid AS uuid, search_index.rank AS rank FROM search_index "
+            "INNER JOIN components ON components.id = search_index.rowid / " %
+            QString::number(sSearchIndexTableCount) % " "
+            "WHERE search_index MATCH :query_cmp "
+            "AND search_index.rowid % " % QString::number(sSearchIndexTableCount) % " = " %
+            QString::number(getSearchIndexTableIndex("components")) % " "
+            "UNION ALL "
+            "SELECT devices.component_uuid AS uuid, search_index.rank AS rank FROM search_index "
+            "INNER JOIN devices ON devices.id = search_index.rowid / " %
+            QString::number(sSearchIndexTableCount) % " "
+            "WHERE search_index MATCH :query_dev "
+            "AND search_index.rowid % " % QString::number(sSearchIndexTableCount) % " = " %
+            QString::number(getSearchIndexTableIndex("devices")) % " "
+            ") GROUP BY uuid ORDER BY MIN(rank) LIMIT :limit");
+        query.bindValue(":query_cmp", ftsQuery);
+        query.bindValue(":query_dev", ftsQuery);
+        query.bindValue(":limit", limit);
+        getDb().exec(query);
+        return getUuidsFromQuery(query);
+    } else {
+        QSqlQuery query = getDb().prepareQuery(
+            "SELECT DISTINCT components.uuid FROM components "
+            "LEFT JOIN components_tr ON components.id = components_tr.component_id "
+            "LEFT JOIN devices ON devices.component_uuid = components.uuid "
+            "LEFT JOIN devices_tr ON devices.id = devices_tr.device_id "
+            "WHERE components_tr.name LIKE :keyword "
+            "OR components_tr.keywords LIKE :keyword "
+            "OR devices_tr.name LIKE :keyword "
+            "OR devices_tr.keywords LIKE :keyword "
+            "LIMIT :limit");
+        query.bindValue(":keyword", "%" + keyword + "%");
+        query.bindValue(":limit", limit);
+        getDb().exec(query);
+        return getUuidsFromQuery(query);
     }
-    return elements;
+}
+
+qint64 WorkspaceLibraryDb::getSearchIndexRowId(const QString& table, int id) noexcept
+{
+    Q_ASSERT(getSearchIndexTableIndex(table) >= 0);
+    return (qint64(id) * sSearchIndexTableCount) + getSearchIndexTableIndex(table);
 }
 
 /*****************************************************************************************
@@ -359,16 +386,30 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept
  *  Private Methods
  ****************************************************************************************/
 
+SQLiteDatabase& WorkspaceLibraryDb::getDb() const
+{
+    if (QThread::currentThread() == thread()) {
+        return *mDb;
+    }
+
+    // database connections must not be shared between threads, so every other thread
+    // gets its own connection (thanks to WAL, readers are not blocked by the scanner)
+    if (!mThreadDbs.hasLocalData()) {
+        mThreadDbs.setLocalData(new SQLiteDatabase(mFilePath)); // can throw
+    }
+    return *mThreadDbs.localData();
+}
+
 void WorkspaceLibraryDb::getElementTranslations(const QString& table,
     const QString& idRow, const FilePath& elemDir, const QStringList& localeOrder,
     QString* name, QString* desc, QString* keywords) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT locale, name, description, keywords FROM " % table % "_tr "
         "INNER JOIN " % table % " ON " % table % ".id=" % table % "_tr." % idRow % " "
         "WHERE " % table % ".filepath = :filepath");
     query.bindValue(":filepath", elemDir.toRelative(mWorkspace.getLibrariesPath()));
-    mDb->exec(query);
+    getDb().exec(query);
 
     LocalizedNameMap nameMap;
     LocalizedDescriptionMap descriptionMap;
@@ -391,10 +432,10 @@ void WorkspaceLibraryDb::getElementTranslations(const QString& table,
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getElementFilePathsFromDb(
     const QString& tablename, const Uuid& uuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT version, filepath FROM " % tablename % " WHERE uuid = :uuid");
     query.bindValue(":uuid", uuid.toStr());
-    mDb->exec(query);
+    getDb().exec(query);
 
     QMultiMap<Version, FilePath> elements;
     while (query.next()) {
@@ -420,10 +461,10 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(const QMultiMap<Version, F
 
 QSet<Uuid> WorkspaceLibraryDb::getCategoryChilds(const QString& tablename, const Uuid& categoryUuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT uuid FROM " % tablename % " WHERE parent_uuid " %
         (categoryUuid.isNull() ? QString("IS NULL") : "= '" % categoryUuid.toStr() % "'"));
-    mDb->exec(query);
+    getDb().exec(query);
 
     QSet<Uuid> elements;
     while (query.next()) {
@@ -453,12 +494,12 @@ QList<Uuid> WorkspaceLibraryDb::getCategoryParents(const QString& tablename, Uui
 
 Uuid WorkspaceLibraryDb::getCategoryParent(const QString& tablename, const Uuid& category) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT parent_uuid FROM " % tablename %
         " WHERE uuid = '" % category.toStr() % "'" %
         " ORDER BY version DESC" %
         " LIMIT 1");
-    mDb->exec(query);
+    getDb().exec(query);
 
     if (query.next()) {
         QVariant value = query.value(0);
@@ -479,12 +520,12 @@ Uuid WorkspaceLibraryDb::getCategoryParent(const QString& tablename, const Uuid&
 QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(const QString& tablename,
     const QString& idrowname, const Uuid& categoryUuid) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT uuid FROM " % tablename % " LEFT JOIN " % tablename % "_cat "
         "ON " % tablename % ".id=" % tablename % "_cat." % idrowname % " "
         "WHERE category_uuid " %
         (categoryUuid.isNull() ? QString("IS NULL") : "= '" % categoryUuid.toStr() % "'"));
-    mDb->exec(query);
+    getDb().exec(query);
 
     QSet<Uuid> elements;
     while (query.next()) {
@@ -501,11 +542,11 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(const QString& tablename,
 int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const
 {
     QString relativeLibraryPath = lib.toRelative(mWorkspace.getLibrariesPath());
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT id FROM libraries "
         "WHERE filepath = '" % relativeLibraryPath % "'"
         "LIMIT 1");
-    mDb->exec(query);
+    getDb().exec(query);
 
     if (query.next()) {
         bool ok = false;
@@ -521,10 +562,10 @@ int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const
 QList<FilePath> WorkspaceLibraryDb::getLibraryElements(const FilePath& lib,
                                                        const QString& tablename) const
 {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT filepath FROM " % tablename % " WHERE lib_id = :lib_id");
     query.bindValue(":lib_id", getLibraryId(lib));
-    mDb->exec(query);
+    getDb().exec(query);
 
     QList<FilePath> elements;
     while (query.next()) {
@@ -539,6 +580,38 @@ QList<FilePath> WorkspaceLibraryDb::getLibraryElements(const FilePath& lib,
     return elements;
 }
 
+QList<Uuid> WorkspaceLibraryDb::getUuidsFromQuery(QSqlQuery& query) const
+{
+    QList<Uuid> elements;
+    while (query.next()) {
+        Uuid uuid(query.value(0).toString());
+        if (!uuid.isNull()) {
+            elements.append(uuid);
+        } else {
+            throw LogicError(__FILE__, __LINE__);
+        }
+    }
+    return elements;
+}
+
+QString WorkspaceLibraryDb::toSearchIndexQuery(const QString& keyword) noexcept
+{
+    // every word is quoted (to not interpret it as FTS5 syntax) and prefix-matched
+    QStringList tokens;
+    foreach (const QString& word, keyword.split(QRegularExpression("\\s+"), QString::SkipEmptyParts)) {
+        tokens.append("\"" % QString(word).replace("\"", "\"\"") % "\"*");
+    }
+    return tokens.join(" ");
+}
+
+int WorkspaceLibraryDb::getSearchIndexTableIndex(const QString& tablename) noexcept
+{
+    static const QStringList tables = {"component_categories", "package_categories",
+                                       "symbols", "packages", "components", "devices"};
+    Q_ASSERT(tables.count() <= sSearchIndexTableCount);
+    return tables.indexOf(tablename);
+}
+
 void WorkspaceLibraryDb::createAllTables()
 {
     QStringList queries;
@@ -577,7 +650,10 @@ void WorkspaceLibraryDb::createAllTables()
                         "`filepath` TEXT UNIQUE NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
-                        "`parent_uuid` TEXT"
+                        "`parent_uuid` TEXT, "
+                        "`fs_mtime` INTEGER NOT NULL DEFAULT 0, "
+                        "`fs_size` INTEGER NOT NULL DEFAULT 0, "
+                        "`content_hash` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS component_categories_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -596,7 +672,10 @@ void WorkspaceLibraryDb::createAllTables()
                         "`filepath` TEXT UNIQUE NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
-                        "`parent_uuid` TEXT"
+                        "`parent_uuid` TEXT, "
+                        "`fs_mtime` INTEGER NOT NULL DEFAULT 0, "
+                        "`fs_size` INTEGER NOT NULL DEFAULT 0, "
+                        "`content_hash` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS package_categories_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -614,7 +693,10 @@ void WorkspaceLibraryDb::createAllTables()
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL"
+                        "`version` TEXT NOT NULL, "
+                        "`fs_mtime` INTEGER NOT NULL DEFAULT 0, "
+                        "`fs_size` INTEGER NOT NULL DEFAULT 0, "
+                        "`content_hash` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS symbols_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -638,7 +720,10 @@ void WorkspaceLibraryDb::createAllTables()
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL "
+                        "`version` TEXT NOT NULL, "
+                        "`fs_mtime` INTEGER NOT NULL DEFAULT 0, "
+                        "`fs_size` INTEGER NOT NULL DEFAULT 0, "
+                        "`content_hash` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS packages_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -662,7 +747,10 @@ void WorkspaceLibraryDb::createAllTables()
                         "`lib_id` INTEGER NOT NULL, "
                         "`filepath` TEXT UNIQUE NOT NULL, "
                         "`uuid` TEXT NOT NULL, "
-                        "`version` TEXT NOT NULL"
+                        "`version` TEXT NOT NULL, "
+                        "`fs_mtime` INTEGER NOT NULL DEFAULT 0, "
+                        "`fs_size` INTEGER NOT NULL DEFAULT 0, "
+                        "`content_hash` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS components_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -688,7 +776,10 @@ void WorkspaceLibraryDb::createAllTables()
                         "`uuid` TEXT NOT NULL, "
                         "`version` TEXT NOT NULL, "
                         "`component_uuid` TEXT NOT NULL, "
-                        "`package_uuid` TEXT NOT NULL"
+                        "`package_uuid` TEXT NOT NULL, "
+                        "`fs_mtime` INTEGER NOT NULL DEFAULT 0, "
+                        "`fs_size` INTEGER NOT NULL DEFAULT 0, "
+                        "`content_hash` TEXT"
                         ")");
     queries << QString( "CREATE TABLE IF NOT EXISTS devices_tr ("
                         "`id` INTEGER PRIMARY KEY NOT NULL, "
@@ -711,6 +802,19 @@ void WorkspaceLibraryDb::createAllTables()
         QSqlQuery query = mDb->prepareQuery(string); // can throw
         mDb->exec(query); // can throw
     }
+
+    // full-text search index (optional since it requires the FTS5 extension of SQLite)
+    try {
+        mDb->exec("CREATE VIRTUAL TABLE IF NOT EXISTS search_index USING fts5("
+                  "name, keywords, description, "
+                  "tokenize = 'unicode61', prefix = '2 3'"
+                  ")"); // can throw
+        // rank matches in names higher than in keywords, and keywords than descriptions
+        mDb->exec("INSERT INTO search_index (search_index, rank) "
+                  "VALUES ('rank', 'bm25(10.0, 5.0, 1.0)')"); // can throw
+    } catch (const Exception& e) {
+        qWarning() << "Full-text search index not available:" << e.getMsg();
+    }
 }
 
 int WorkspaceLibraryDb::getDbVersion() const noexcept
@@ -24,6 +24,7 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <QtSql>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
@@ -47,6 +48,11 @@ class WorkspaceLibraryScanner;
 
 /**
  * @brief The WorkspaceLibraryDb class
+ *
+ * All getters may be called from any thread (e.g. to run time-consuming queries in a
+ * worker thread). Threads other than the one which created this object use their own
+ * database connection, which is opened on first use and closed when the thread exits.
+ * So make sure all these threads are finished before this object gets destroyed!
  */
 class WorkspaceLibraryDb final : public QObject
 {
@@ -106,7 +112,43 @@ class WorkspaceLibraryDb final : public QObject
         QSet<Uuid> getComponentsByCategory(const Uuid& category) const;
         QSet<Uuid> getDevicesByCategory(const Uuid& category) const;
         QSet<Uuid> getDevicesOfComponent(const Uuid& component) const;
-        QSet<Uuid> getComponentsBySearchKeyword(const QString& keyword) const;
+
+        /**
+         * @brief Search components by a keyword in the components and their devices
+         *
+         * If the full-text search index is available (see #hasSearchIndex()), every
+         * word of the keyword is prefix-matched against the names, keywords and
+         * descriptions (in all locales) and the results are ordered by relevance
+         * (best match first). Otherwise a simple substring search is done.
+         *
+         * @param keyword   The search term entered by the user
+         * @param limit     Maximum number of results (-1 = unlimited)
+         *
+         * @return UUIDs of all matching components, best match first
+         */
+        QList<Uuid> getComponentsBySearchKeyword(const QString& keyword, int limit = -1) const;
+
+        /**
+         * @brief Check whether the full-text search index is available
+         *
+         * The index requires the FTS5 extension of SQLite, which may not be compiled
+         * into the SQLite driver.
+         */
+        bool hasSearchIndex() const noexcept {return mHasSearchIndex;}
+
+        /**
+         * @brief Get the rowid of an element in the full-text search index
+         *
+         * The search index contains one row per element of all element tables. Its rowid
+         * is derived from the element table and the element id, so the row of a
+         * specific element can be found fast (e.g. to remove it).
+         *
+         * @param table     The element table (e.g. "symbols")
+         * @param id        The element id in that table
+         *
+         * @return The rowid in the table "search_index"
+         */
+        static qint64 getSearchIndexRowId(const QString& table, int id) noexcept;
 
         // General Methods
 
@@ -130,6 +172,7 @@ class WorkspaceLibraryDb final : public QObject
     private:
 
         // Private Methods
+        SQLiteDatabase& getDb() const;
         void getElementTranslations(const QString& table, const QString& idRow,
                                     const FilePath& elemDir, const QStringList& localeOrder,
                                     QString* name, QString* desc, QString* keywords) const;
@@ -143,6 +186,9 @@ class WorkspaceLibraryDb final : public QObject
                                          const Uuid& categoryUuid) const;
         int getLibraryId(const FilePath& lib) const;
         QList<FilePath> getLibraryElements(const FilePath& lib, const QString& tablename) const;
+        QList<Uuid> getUuidsFromQuery(QSqlQuery& query) const;
+        static QString toSearchIndexQuery(const QString& keyword) noexcept;
+        static int getSearchIndexTableIndex(const QString& tablename) noexcept;
         void createAllTables();
         void setDbVersion(int version);
         int getDbVersion() const noexcept;
@@ -150,11 +196,15 @@ class WorkspaceLibraryDb final : public QObject
 
         // Attributes
         Workspace& mWorkspace;
-        QScopedPointer<SQLiteDatabase> mDb; ///< the SQLite database "cache.sqlite"
+        FilePath mFilePath; ///< path to the SQLite database "cache.sqlite"
+        QScopedPointer<SQLiteDatabase> mDb; ///< connection of the thread owning this object
+        mutable QThreadStorage<SQLiteDatabase*> mThreadDbs; ///< connections of other threads
         QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+        bool mHasSearchIndex;
 
         // Constants
-        static const int sCurrentDbVersion = 1;
+        static const int sCurrentDbVersion = 3;
+        static const int sSearchIndexTableCount = 8; ///< see #getSearchIndexRowId()
 };
 
 /*****************************************************************************************
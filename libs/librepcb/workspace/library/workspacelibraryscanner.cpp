@@ -23,8 +23,10 @@
 #include <QtCore>
 #include "workspacelibraryscanner.h"
 #include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/library/elements.h>
 #include "../workspace.h"
+#include "workspacelibrarydb.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -34,12 +36,96 @@ namespace workspace {
 
 using namespace library;
 
+/*****************************************************************************************
+ *  Class ElementDataQueue
+ ****************************************************************************************/
+
+/**
+ * @brief Bounded, thread-safe queue to pass parsed elements to the database writer
+ *
+ * The parser threads block in #push() as long as the queue is full, so the memory
+ * consumption is limited even if the database writer is slower than the parsers. After
+ * #close() was called, #push() never blocks anymore and just discards the elements.
+ */
+class WorkspaceLibraryScanner::ElementDataQueue final
+{
+    public:
+        explicit ElementDataQueue(int capacity) noexcept :
+            mCapacity(capacity), mClosed(false) {}
+
+        bool isClosed() const noexcept {
+            QMutexLocker locker(&mMutex);
+            return mClosed;
+        }
+
+        void push(const ElementData& data) noexcept {
+            QMutexLocker locker(&mMutex);
+            while ((mQueue.count() >= mCapacity) && (!mClosed)) {
+                mNotFull.wait(&mMutex);
+            }
+            if (!mClosed) {
+                mQueue.enqueue(data);
+                mNotEmpty.wakeOne();
+            }
+        }
+
+        ElementData pop() noexcept {
+            QMutexLocker locker(&mMutex);
+            while (mQueue.isEmpty()) {
+                mNotEmpty.wait(&mMutex);
+            }
+            ElementData data = mQueue.dequeue();
+            mNotFull.wakeOne();
+            return data;
+        }
+
+        void close() noexcept {
+            QMutexLocker locker(&mMutex);
+            mClosed = true;
+            mQueue.clear();
+            mNotFull.wakeAll();
+        }
+
+    private:
+        mutable QMutex mMutex;
+        QWaitCondition mNotFull;
+        QWaitCondition mNotEmpty;
+        QQueue<ElementData> mQueue;
+        int mCapacity;
+        bool mClosed;
+};
+
+/*****************************************************************************************
+ *  Class ParserJob
+ ****************************************************************************************/
+
+/**
+ * @brief Parses one library element in a thread of the pool and enqueues the result
+ */
+class WorkspaceLibraryScanner::ParserJob final : public QRunnable
+{
+    public:
+        ParserJob(const ElementData& data, ElementDataQueue& queue) noexcept :
+            QRunnable(), mData(data), mQueue(queue) {}
+
+        void run() noexcept override {
+            if (!mQueue.isClosed()) {
+                mData.parse(mData);
+                mQueue.push(mData);
+            }
+        }
+
+    private:
+        ElementData mData;
+        ElementDataQueue& mQueue;
+};
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
 WorkspaceLibraryScanner::WorkspaceLibraryScanner(Workspace& ws) noexcept :
-    QThread(nullptr), mWorkspace(ws), mAbort(false)
+    QThread(nullptr), mWorkspace(ws), mAbort(false), mHasSearchIndex(false)
 {
 }
 
@@ -77,43 +163,100 @@ void WorkspaceLibraryScanner::run() noexcept
         // begin database transaction
         SQLiteDatabase::TransactionScopeGuard transactionGuard(db); // can throw
 
-        // clear all tables
-        clearAllTables(db);
+        // the full-text search index is optional (see WorkspaceLibraryDb::hasSearchIndex())
+        mHasSearchIndex = db.isExistingTable("search_index"); // can throw
+
+        // get all libraries which are currently in the database
+        QSet<int> obsoleteLibIds;
+        QSqlQuery query = db.prepareQuery("SELECT id FROM libraries");
+        db.exec(query);
+        while (query.next()) {
+            obsoleteLibIds.insert(query.value(0).toInt());
+        }
 
-        // scan all libraries
+        // update all libraries and determine which elements need to be parsed
         int count = 0;
-        qreal percent = 0;
+        QList<ElementData> modifiedElements;
         foreach (const QSharedPointer<Library>& lib, libraries) {
-            int libId = addLibraryToDb(db, lib);
-            if (mAbort) break;
-            count += addCategoriesToDb<ComponentCategory>(db, lib->searchForElements<ComponentCategory>(),
-                                                          "component_categories", "cat_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
             if (mAbort) break;
-            count += addCategoriesToDb<PackageCategory>(db, lib->searchForElements<PackageCategory>(),
-                                                        "package_categories", "cat_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
-            if (mAbort) break;
-            count += addElementsToDb<Symbol>(db, lib->searchForElements<Symbol>(),
-                                             "symbols", "symbol_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
-            if (mAbort) break;
-            count += addElementsToDb<Package>(db, lib->searchForElements<Package>(),
-                                              "packages", "package_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            int libId = updateLibraryInDb(db, lib);
+            obsoleteLibIds.remove(libId);
+            count += prepareElementsUpdate<ComponentCategory>(db, lib->searchForElements<ComponentCategory>(),
+                "component_categories", "cat_id", libId, modifiedElements);
+            count += prepareElementsUpdate<PackageCategory>(db, lib->searchForElements<PackageCategory>(),
+                "package_categories", "cat_id", libId, modifiedElements);
+            count += prepareElementsUpdate<Symbol>(db, lib->searchForElements<Symbol>(),
+                "symbols", "symbol_id", libId, modifiedElements);
+            count += prepareElementsUpdate<Package>(db, lib->searchForElements<Package>(),
+                "packages", "package_id", libId, modifiedElements);
+            count += prepareElementsUpdate<Component>(db, lib->searchForElements<Component>(),
+                "components", "component_id", libId, modifiedElements);
+            count += prepareElementsUpdate<Device>(db, lib->searchForElements<Device>(),
+                "devices", "device_id", libId, modifiedElements);
+        }
+
+        // remove libraries which do no longer exist
+        foreach (int libId, obsoleteLibIds) {
             if (mAbort) break;
-            count += addElementsToDb<Component>(db, lib->searchForElements<Component>(),
-                                                "components", "component_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            removeLibraryFromDb(db, libId);
+        }
+
+        // parse all new or modified elements in parallel
+        QThreadPool pool;
+        pool.setMaxThreadCount(QThread::idealThreadCount());
+        ElementDataQueue queue(4 * pool.maxThreadCount());
+        auto sg = scopeGuard([&](){
+            // make sure no parser is blocked anymore, then wait until all are finished
+            queue.close();
+            pool.clear();
+            pool.waitForDone();
+        });
+        foreach (const ElementData& element, modifiedElements) {
             if (mAbort) break;
-            count += addDevicesToDb(db, lib->searchForElements<Device>(),
-                                    "devices", "device_id", libId);
-            emit progressUpdate(percent += qreal(100) / (libraries.count() * 6));
+            QRunnable* job = new ParserJob(element, queue);
+            pool.start(job);
+        }
+
+        // write the parsed elements into the database, in the order they are ready
+        PendingRowsMap pendingRows;
+        int pendingRowsCount = 0;
+        int percent = 0;
+        for (int i = 0; (i < modifiedElements.count()) && (!mAbort); ++i) {
+            ElementData data = queue.pop();
+            switch (data.state) {
+                case ElementData::State::Unmodified:
+                    updateElementStampInDb(db, data.table, data.oldId, data.stamp);
+                    count++;
+                    break;
+                case ElementData::State::Parsed:
+                    if (data.oldId >= 0) {
+                        removeElementFromDb(db, data.table, data.idColumn, data.oldId);
+                    }
+                    writeElementToDb(db, data, pendingRows);
+                    pendingRowsCount += data.translations.count() + data.categories.count();
+                    count++;
+                    break;
+                default:
+                    if (data.oldId >= 0) {
+                        removeElementFromDb(db, data.table, data.idColumn, data.oldId);
+                    }
+                    break;
+            }
+            if (pendingRowsCount >= sMaxPendingRows) {
+                flushPendingRows(db, pendingRows);
+                pendingRowsCount = 0;
+            }
+            int newPercent = (100 * (i + 1)) / modifiedElements.count();
+            if (newPercent != percent) {
+                emit progressUpdate(percent = newPercent);
+            }
         }
 
         // commit transaction
         if (!mAbort) {
+            flushPendingRows(db, pendingRows);
             transactionGuard.commit(); // can throw
+            if (percent < 100) emit progressUpdate(100);
             emit succeeded(count);
         }
     } catch (const Exception& e) {
@@ -121,52 +264,38 @@ void WorkspaceLibraryScanner::run() noexcept
     }
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db)
-{
-    // libraries
-    db.clearTable("libraries_tr");
-    db.clearTable("libraries");
-
-    // component categories
-    db.clearTable("component_categories_tr");
-    db.clearTable("component_categories");
-
-    // package categories
-    db.clearTable("package_categories_tr");
-    db.clearTable("package_categories");
-
-    // symbols
-    db.clearTable("symbols_tr");
-    db.clearTable("symbols_cat");
-    db.clearTable("symbols");
-
-    // packages
-    db.clearTable("packages_tr");
-    db.clearTable("packages_cat");
-    db.clearTable("packages");
-
-    // components
-    db.clearTable("components_tr");
-    db.clearTable("components_cat");
-    db.clearTable("components");
-
-    // devices
-    db.clearTable("devices_tr");
-    db.clearTable("devices_cat");
-    db.clearTable("devices");
-}
-
-int WorkspaceLibraryScanner::addLibraryToDb(SQLiteDatabase& db,
-                                            const QSharedPointer<library::Library>& lib)
+int WorkspaceLibraryScanner::updateLibraryInDb(SQLiteDatabase& db,
+                                               const QSharedPointer<library::Library>& lib)
 {
+    QString filepath = lib->getFilePath().toRelative(mWorkspace.getLibrariesPath());
     QSqlQuery query = db.prepareQuery(
-        "INSERT INTO libraries "
-        "(filepath, uuid, version) VALUES "
-        "(:filepath, :uuid, :version)");
-    query.bindValue(":filepath",    lib->getFilePath().toRelative(mWorkspace.getLibrariesPath()));
-    query.bindValue(":uuid",        lib->getUuid().toStr());
-    query.bindValue(":version",     lib->getVersion().toStr());
-    int id = db.insert(query);
+        "SELECT id FROM libraries WHERE filepath = :filepath");
+    query.bindValue(":filepath", filepath);
+    db.exec(query);
+
+    int id = -1;
+    if (query.next()) {
+        id = query.value(0).toInt();
+        QSqlQuery query = db.prepareQuery(
+            "UPDATE libraries SET uuid = :uuid, version = :version WHERE id = :id");
+        query.bindValue(":uuid",        lib->getUuid().toStr());
+        query.bindValue(":version",     lib->getVersion().toStr());
+        query.bindValue(":id",          id);
+        db.exec(query);
+        QSqlQuery deleteQuery = db.prepareQuery(
+            "DELETE FROM libraries_tr WHERE lib_id = :lib_id");
+        deleteQuery.bindValue(":lib_id", id);
+        db.exec(deleteQuery);
+    } else {
+        QSqlQuery query = db.prepareQuery(
+            "INSERT INTO libraries "
+            "(filepath, uuid, version) VALUES "
+            "(:filepath, :uuid, :version)");
+        query.bindValue(":filepath",    filepath);
+        query.bindValue(":uuid",        lib->getUuid().toStr());
+        query.bindValue(":version",     lib->getVersion().toStr());
+        id = db.insert(query);
+    }
     foreach (const QString& locale, lib->getAllAvailableLocales()) {
         QSqlQuery query = db.prepareQuery(
             "INSERT INTO libraries_tr "
@@ -182,140 +311,294 @@ int WorkspaceLibraryScanner::addLibraryToDb(SQLiteDatabase& db,
     return id;
 }
 
-template <typename ElementType>
-int WorkspaceLibraryScanner::addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-    const QString& table, const QString& idColumn, int libId)
+void WorkspaceLibraryScanner::removeLibraryFromDb(SQLiteDatabase& db, int libId)
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs) {
-        if (mAbort) break;
-        try {
-            ElementType element(filepath, true); // can throw
-            QSqlQuery query = db.prepareQuery(
-                "INSERT INTO " % table % " "
-                "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-                "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-            query.bindValue(":lib_id",      libId);
-            query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",        element.getUuid().toStr());
-            query.bindValue(":version",     element.getVersion().toStr());
-            query.bindValue(":parent_uuid", element.getParentUuid().isNull() ? QVariant(QVariant::String) : element.getParentUuid().toStr());
-            int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_tr "
-                    "(" % idColumn % ", locale, name, description, keywords) VALUES "
-                    "(:element_id, :locale, :name, :description, :keywords)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
-                db.insert(query);
-            }
-            count++;
-        } catch (const Exception& e) {
-            qWarning() << "Failed to open library element:" << filepath.toNative();
+    static const QList<QPair<QString, QString>> tables = {
+        qMakePair(QString("component_categories"), QString("cat_id")),
+        qMakePair(QString("package_categories"), QString("cat_id")),
+        qMakePair(QString("symbols"), QString("symbol_id")),
+        qMakePair(QString("packages"), QString("package_id")),
+        qMakePair(QString("components"), QString("component_id")),
+        qMakePair(QString("devices"), QString("device_id")),
+    };
+    for (const auto& table : tables) {
+        foreach (const DbElementEntry& entry, getElementsFromDb(db, table.first, libId)) {
+            removeElementFromDb(db, table.first, table.second, entry.id);
         }
     }
-    return count;
+
+    QSqlQuery trQuery = db.prepareQuery("DELETE FROM libraries_tr WHERE lib_id = :lib_id");
+    trQuery.bindValue(":lib_id", libId);
+    db.exec(trQuery);
+    QSqlQuery query = db.prepareQuery("DELETE FROM libraries WHERE id = :id");
+    query.bindValue(":id", libId);
+    db.exec(query);
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-    const QString& table, const QString& idColumn, int libId)
+int WorkspaceLibraryScanner::prepareElementsUpdate(SQLiteDatabase& db,
+    const QList<FilePath>& dirs, const QString& table, const QString& idColumn, int libId,
+    QList<ElementData>& modifiedElements)
 {
-    int count = 0;
+    // all elements of this library in the database which were not found (yet) on disk
+    QHash<QString, DbElementEntry> obsoleteElements = getElementsFromDb(db, table, libId);
+
+    int unmodifiedCount = 0;
     foreach (const FilePath& filepath, dirs) {
         if (mAbort) break;
-        try {
-            ElementType element(filepath, true); // can throw
-            QSqlQuery query = db.prepareQuery(
-                "INSERT INTO " % table % " "
-                "(lib_id, filepath, uuid, version) VALUES "
-                "(:lib_id, :filepath, :uuid, :version)");
-            query.bindValue(":lib_id",      libId);
-            query.bindValue(":filepath",    filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",        element.getUuid().toStr());
-            query.bindValue(":version",     element.getVersion().toStr());
-            int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_tr "
-                    "(" % idColumn % ", locale, name, description, keywords) VALUES "
-                    "(:element_id, :locale, :name, :description, :keywords)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
-                db.insert(query);
-            }
-            foreach (const Uuid& categoryUuid, element.getCategories()) {
-                Q_ASSERT(!categoryUuid.isNull());
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_cat "
-                    "(" % idColumn % ", category_uuid) VALUES "
-                    "(:element_id, :category_uuid)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":category_uuid", categoryUuid.toStr());
-                db.insert(query);
-            }
-            count++;
-        } catch (const Exception& e) {
-            qWarning() << "Failed to open library element:" << filepath.toNative();
+        QString relativePath = filepath.toRelative(mWorkspace.getLibrariesPath());
+        ElementDirStamp stamp = getElementDirStamp(filepath, false);
+        bool exists = obsoleteElements.contains(relativePath);
+        DbElementEntry entry = obsoleteElements.take(relativePath);
+        if (exists && (entry.stamp.mtime == stamp.mtime) && (entry.stamp.size == stamp.size)) {
+            unmodifiedCount++; // element is unchanged since the last scan
+            continue;
+        }
+        ElementData data;
+        data.parse = &parseElement<ElementType>;
+        data.filepath = filepath;
+        data.table = table;
+        data.idColumn = idColumn;
+        data.libId = libId;
+        data.oldId = exists ? entry.id : -1;
+        data.oldHash = exists ? entry.stamp.hash : QByteArray();
+        data.state = ElementData::State::Failed;
+        data.stamp = stamp;
+        modifiedElements.append(data);
+    }
+
+    // remove elements which do no longer exist
+    if (!mAbort) {
+        foreach (const DbElementEntry& entry, obsoleteElements) {
+            removeElementFromDb(db, table, idColumn, entry.id);
         }
     }
-    return count;
+    return unmodifiedCount;
 }
 
-int WorkspaceLibraryScanner::addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-    const QString& table, const QString& idColumn, int libId)
+void WorkspaceLibraryScanner::writeElementToDb(SQLiteDatabase& db, const ElementData& data,
+                                               PendingRowsMap& pendingRows)
 {
-    int count = 0;
-    foreach (const FilePath& filepath, dirs) {
-        if (mAbort) break;
-        try {
-            Device element(filepath, true); // can throw
-            QSqlQuery query = db.prepareQuery(
-                "INSERT INTO " % table % " "
-                "(lib_id, filepath, uuid, version, component_uuid, package_uuid) VALUES "
-                "(:lib_id, :filepath, :uuid, :version, :component_uuid, :package_uuid)");
-            query.bindValue(":lib_id",      libId);
-            query.bindValue(":filepath",        filepath.toRelative(mWorkspace.getLibrariesPath()));
-            query.bindValue(":uuid",            element.getUuid().toStr());
-            query.bindValue(":version",         element.getVersion().toStr());
-            query.bindValue(":component_uuid",  element.getComponentUuid().toStr());
-            query.bindValue(":package_uuid",    element.getPackageUuid().toStr());
-            int id = db.insert(query);
-            foreach (const QString& locale, element.getAllAvailableLocales()) {
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_tr "
-                    "(" % idColumn % ", locale, name, description, keywords) VALUES "
-                    "(:element_id, :locale, :name, :description, :keywords)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":locale",      locale);
-                query.bindValue(":name",        element.getNames().value(locale));
-                query.bindValue(":description", element.getDescriptions().value(locale));
-                query.bindValue(":keywords",    element.getKeywords().value(locale));
-                db.insert(query);
-            }
-            foreach (const Uuid& categoryUuid, element.getCategories()) {
-                Q_ASSERT(!categoryUuid.isNull());
-                QSqlQuery query = db.prepareQuery(
-                    "INSERT INTO " % table % "_cat "
-                    "(" % idColumn % ", category_uuid) VALUES "
-                    "(:element_id, :category_uuid)");
-                query.bindValue(":element_id",  id);
-                query.bindValue(":category_uuid", categoryUuid.toStr());
-                db.insert(query);
+    QStringList columns = {"lib_id", "filepath", "fs_mtime", "fs_size", "content_hash"};
+    QVariantList values = {data.libId, data.filepath.toRelative(mWorkspace.getLibrariesPath()),
+                           data.stamp.mtime, data.stamp.size, QString(data.stamp.hash.toHex())};
+    for (const auto& column : data.columns) {
+        columns.append(column.first);
+        values.append(column.second);
+    }
+    QSqlQuery query = db.prepareCachedQuery(
+        "INSERT INTO " % data.table % " "
+        "(" % columns.join(", ") % ") VALUES "
+        "(:" % columns.join(", :") % ")");
+    for (int i = 0; i < columns.count(); ++i) {
+        query.bindValue(":" % columns.at(i), values.at(i));
+    }
+    int id = db.insert(query);
+
+    // translations and categories are inserted later in batches
+    PendingRows& translations = pendingRows[data.table % "_tr"];
+    if (translations.columns.isEmpty()) {
+        translations.columns = QStringList{data.idColumn, "locale", "name", "description", "keywords"};
+    }
+    foreach (const ElementTranslation& translation, data.translations) {
+        translations.rows.append(QVariantList{id, translation.locale, translation.name,
+                                              translation.description, translation.keywords});
+    }
+    if (!data.categories.isEmpty()) {
+        PendingRows& categories = pendingRows[data.table % "_cat"];
+        if (categories.columns.isEmpty()) {
+            categories.columns = QStringList{data.idColumn, "category_uuid"};
+        }
+        foreach (const Uuid& categoryUuid, data.categories) {
+            Q_ASSERT(!categoryUuid.isNull());
+            categories.rows.append(QVariantList{id, categoryUuid.toStr()});
+        }
+    }
+
+    // the search index contains the texts of all locales in a single row per element
+    if (mHasSearchIndex) {
+        QStringList names, keywords, descriptions;
+        foreach (const ElementTranslation& translation, data.translations) {
+            names.append(translation.name);
+            keywords.append(translation.keywords);
+            descriptions.append(translation.description);
+        }
+        PendingRows& searchIndex = pendingRows["search_index"];
+        if (searchIndex.columns.isEmpty()) {
+            searchIndex.columns = QStringList{"rowid", "name", "keywords", "description"};
+        }
+        searchIndex.rows.append(QVariantList{
+            WorkspaceLibraryDb::getSearchIndexRowId(data.table, id), names.join("\n"),
+            keywords.join("\n"), descriptions.join("\n")});
+    }
+}
+
+void WorkspaceLibraryScanner::flushPendingRows(SQLiteDatabase& db, PendingRowsMap& pendingRows)
+{
+    for (auto it = pendingRows.begin(); it != pendingRows.end(); ++it) {
+        db.insertMultiple(it.key(), it.value().columns, it.value().rows); // can throw
+        it.value().rows.clear();
+    }
+}
+
+void WorkspaceLibraryScanner::updateElementStampInDb(SQLiteDatabase& db, const QString& table,
+                                                     int id, const ElementDirStamp& stamp)
+{
+    QSqlQuery query = db.prepareCachedQuery(
+        "UPDATE " % table % " SET fs_mtime = :fs_mtime, fs_size = :fs_size "
+        "WHERE id = :id");
+    query.bindValue(":fs_mtime",    stamp.mtime);
+    query.bindValue(":fs_size",     stamp.size);
+    query.bindValue(":id",          id);
+    db.exec(query);
+}
+
+void WorkspaceLibraryScanner::removeElementFromDb(SQLiteDatabase& db, const QString& table,
+                                                  const QString& idColumn, int id)
+{
+    // remove referencing rows first, otherwise the foreign key constraints would fail
+    QSqlQuery trQuery = db.prepareCachedQuery(
+        "DELETE FROM " % table % "_tr WHERE " % idColumn % " = :id");
+    trQuery.bindValue(":id", id);
+    db.exec(trQuery);
+    if (hasCategoriesTable(table)) {
+        QSqlQuery catQuery = db.prepareCachedQuery(
+            "DELETE FROM " % table % "_cat WHERE " % idColumn % " = :id");
+        catQuery.bindValue(":id", id);
+        db.exec(catQuery);
+    }
+    if (mHasSearchIndex) {
+        QSqlQuery searchQuery = db.prepareCachedQuery(
+            "DELETE FROM search_index WHERE rowid = :rowid");
+        searchQuery.bindValue(":rowid", WorkspaceLibraryDb::getSearchIndexRowId(table, id));
+        db.exec(searchQuery);
+    }
+    QSqlQuery query = db.prepareCachedQuery("DELETE FROM " % table % " WHERE id = :id");
+    query.bindValue(":id", id);
+    db.exec(query);
+}
+
+QHash<QString, WorkspaceLibraryScanner::DbElementEntry> WorkspaceLibraryScanner::getElementsFromDb(
+    SQLiteDatabase& db, const QString& table, int libId)
+{
+    QSqlQuery query = db.prepareQuery(
+        "SELECT id, filepath, fs_mtime, fs_size, content_hash FROM " % table % " "
+        "WHERE lib_id = :lib_id");
+    query.bindValue(":lib_id", libId);
+    db.exec(query);
+
+    QHash<QString, DbElementEntry> elements;
+    while (query.next()) {
+        DbElementEntry entry;
+        entry.id = query.value(0).toInt();
+        entry.stamp.mtime = query.value(2).toLongLong();
+        entry.stamp.size = query.value(3).toLongLong();
+        entry.stamp.hash = QByteArray::fromHex(query.value(4).toString().toLatin1());
+        elements.insert(query.value(1).toString(), entry);
+    }
+    return elements;
+}
+
+template <typename ElementType>
+void WorkspaceLibraryScanner::parseElement(ElementData& data) noexcept
+{
+    data.stamp = getElementDirStamp(data.filepath, true);
+    if ((data.oldId >= 0) && (!data.stamp.hash.isEmpty()) && (data.stamp.hash == data.oldHash)) {
+        data.state = ElementData::State::Unmodified; // only touched, not modified
+        return;
+    }
+    try {
+        // the element is only used (and destroyed) in this worker thread, see the
+        // thread rules of library::LibraryBaseElement
+        ElementType element(data.filepath, true); // can throw
+        fillElementData(data, element);
+        data.state = ElementData::State::Parsed;
+    } catch (const Exception& e) {
+        qWarning() << "Failed to open library element:" << data.filepath.toNative();
+        data.state = ElementData::State::Failed;
+    }
+}
+
+void WorkspaceLibraryScanner::fillElementData(ElementData& data,
+                                              const library::LibraryCategory& element)
+{
+    fillElementBaseData(data, element);
+    data.columns.append(qMakePair(QString("parent_uuid"), element.getParentUuid().isNull()
+        ? QVariant(QVariant::String) : QVariant(element.getParentUuid().toStr())));
+}
+
+void WorkspaceLibraryScanner::fillElementData(ElementData& data,
+                                              const library::LibraryElement& element)
+{
+    fillElementBaseData(data, element);
+    data.categories = element.getCategories();
+}
+
+void WorkspaceLibraryScanner::fillElementData(ElementData& data,
+                                              const library::Device& element)
+{
+    fillElementData(data, static_cast<const LibraryElement&>(element));
+    data.columns.append(qMakePair(QString("component_uuid"),
+                                  QVariant(element.getComponentUuid().toStr())));
+    data.columns.append(qMakePair(QString("package_uuid"),
+                                  QVariant(element.getPackageUuid().toStr())));
+}
+
+void WorkspaceLibraryScanner::fillElementBaseData(ElementData& data,
+                                                  const library::LibraryBaseElement& element)
+{
+    data.columns.append(qMakePair(QString("uuid"), QVariant(element.getUuid().toStr())));
+    data.columns.append(qMakePair(QString("version"), QVariant(element.getVersion().toStr())));
+    foreach (const QString& locale, element.getAllAvailableLocales()) {
+        ElementTranslation translation;
+        translation.locale = locale;
+        translation.name = element.getNames().value(locale);
+        translation.description = element.getDescriptions().value(locale);
+        translation.keywords = element.getKeywords().value(locale);
+        data.translations.append(translation);
+    }
+}
+
+bool WorkspaceLibraryScanner::hasCategoriesTable(const QString& table) noexcept
+{
+    return (table != "component_categories") && (table != "package_categories");
+}
+
+WorkspaceLibraryScanner::ElementDirStamp WorkspaceLibraryScanner::getElementDirStamp(
+    const FilePath& dir, bool withHash) noexcept
+{
+    ElementDirStamp stamp;
+    stamp.mtime = QFileInfo(dir.toStr()).lastModified().toMSecsSinceEpoch();
+    stamp.size = 0;
+
+    // collect all files (sorted to get a deterministic hash)
+    QStringList files;
+    QDirIterator it(dir.toStr(), QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot |
+                    QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        QFileInfo info = it.fileInfo();
+        stamp.mtime = qMax(stamp.mtime, info.lastModified().toMSecsSinceEpoch());
+        if (info.isFile()) {
+            stamp.size += info.size();
+            files.append(it.filePath());
+        }
+    }
+    files.sort();
+
+    if (withHash) {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        foreach (const QString& filepath, files) {
+            QFile file(filepath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                return stamp; // leave hash empty -> element will be parsed again
             }
-            count++;
-        } catch (const Exception& e) {
-            qWarning() << "Failed to open library element:" << filepath.toNative();
+            hash.addData(FilePath(filepath).toRelative(dir).toUtf8());
+            hash.addData(file.readAll());
         }
+        stamp.hash = hash.result();
     }
-    return count;
+    return stamp;
 }
 
 /*****************************************************************************************
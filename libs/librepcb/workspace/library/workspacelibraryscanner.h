@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/uuid.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -36,6 +37,10 @@ class SQLiteDatabase;
 
 namespace library {
 class Library;
+class LibraryBaseElement;
+class LibraryCategory;
+class LibraryElement;
+class Device;
 }
 
 namespace workspace {
@@ -49,6 +54,17 @@ class Workspace;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * The scanner updates the library database incrementally: For every element directory
+ * the modification time, size and content hash are stored in the database. On a rescan,
+ * only new or modified elements are parsed again, and rows of removed elements (or
+ * libraries) are deleted. So a rescan without any changes in the libraries only costs
+ * a walk through the element directories.
+ *
+ * Parsing the element files is CPU-bound and independent per element, so it is done
+ * in a pool of worker threads (one per CPU core). The parsed data is passed over a
+ * bounded queue to the scanner thread itself, which is the only one writing to the
+ * database.
+ *
  * @warning Be very careful with dependencies to other objects as the #run() method is
  *          executed in a separate thread! Keep the number of dependencies as small as
  *          possible and consider thread synchronization and object lifetimes.
@@ -84,25 +100,111 @@ class WorkspaceLibraryScanner final : public QThread
         void failed(QString errorMsg);
 
 
+    private: // Types
+
+        /**
+         * @brief Filesystem state of a library element directory
+         *
+         * The modification time and size are cheap to determine and are used to detect
+         * unchanged elements without opening any file. Only if one of them differs, the
+         * (expensive) content hash is calculated to decide whether the element really
+         * needs to be parsed again.
+         */
+        struct ElementDirStamp {
+            qint64 mtime;       ///< Latest modification time [ms since epoch]
+            qint64 size;        ///< Total size of all files [bytes]
+            QByteArray hash;    ///< Hash over all file names and contents (may be empty)
+        };
+
+        struct DbElementEntry {
+            int id;
+            ElementDirStamp stamp;
+        };
+
+        struct ElementTranslation {
+            QString locale;
+            QString name;
+            QString description;
+            QString keywords;
+        };
+
+        /**
+         * @brief A library element which needs to be (re-)parsed
+         *
+         * The input attributes are set by the database writer (#run()), the output
+         * attributes are set by the parser (#parseElement()) in a worker thread. Since
+         * it contains only plain data, it can safely be passed between threads.
+         */
+        struct ElementData {
+            enum class State {Failed, Unmodified, Parsed};
+
+            // Input
+            void (*parse)(ElementData& data);   ///< Parser function (see #parseElement())
+            FilePath filepath;
+            QString table;
+            QString idColumn;
+            int libId;
+            int oldId;                          ///< -1 if not yet in the database
+            QByteArray oldHash;
+
+            // Output
+            State state;
+            ElementDirStamp stamp;
+            QList<QPair<QString, QVariant>> columns;  ///< Element specific columns
+            QList<ElementTranslation> translations;
+            QSet<Uuid> categories;
+        };
+
+        /**
+         * @brief Rows to be inserted into a table with SQLiteDatabase::insertMultiple()
+         */
+        struct PendingRows {
+            QStringList columns;
+            QList<QVariantList> rows;
+        };
+        typedef QHash<QString, PendingRows> PendingRowsMap; ///< key: table name
+
+        class ElementDataQueue;
+        class ParserJob;
+
+
     private: // Methods
 
         void run() noexcept override;
-        void clearAllTables(SQLiteDatabase& db);
-        int addLibraryToDb(SQLiteDatabase& db, const QSharedPointer<library::Library>& lib);
+        int updateLibraryInDb(SQLiteDatabase& db, const QSharedPointer<library::Library>& lib);
+        void removeLibraryFromDb(SQLiteDatabase& db, int libId);
         template <typename ElementType>
-        int addCategoriesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                              const QString& table, const QString& idColumn, int libId);
+        int prepareElementsUpdate(SQLiteDatabase& db, const QList<FilePath>& dirs,
+                                  const QString& table, const QString& idColumn, int libId,
+                                  QList<ElementData>& modifiedElements);
+        void writeElementToDb(SQLiteDatabase& db, const ElementData& data,
+                              PendingRowsMap& pendingRows);
+        void flushPendingRows(SQLiteDatabase& db, PendingRowsMap& pendingRows);
+        void updateElementStampInDb(SQLiteDatabase& db, const QString& table, int id,
+                                    const ElementDirStamp& stamp);
+        void removeElementFromDb(SQLiteDatabase& db, const QString& table,
+                                 const QString& idColumn, int id);
+        QHash<QString, DbElementEntry> getElementsFromDb(SQLiteDatabase& db,
+                                                         const QString& table, int libId);
         template <typename ElementType>
-        int addElementsToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                            const QString& table, const QString& idColumn, int libId);
-        int addDevicesToDb(SQLiteDatabase& db, const QList<FilePath>& dirs,
-                           const QString& table, const QString& idColumn, int libId);
+        static void parseElement(ElementData& data) noexcept;
+        static void fillElementData(ElementData& data, const library::LibraryCategory& element);
+        static void fillElementData(ElementData& data, const library::LibraryElement& element);
+        static void fillElementData(ElementData& data, const library::Device& element);
+        static void fillElementBaseData(ElementData& data,
+                                        const library::LibraryBaseElement& element);
+        static bool hasCategoriesTable(const QString& table) noexcept;
+        static ElementDirStamp getElementDirStamp(const FilePath& dir, bool withHash) noexcept;
 
 
     private: // Data
 
         Workspace& mWorkspace;
         volatile bool mAbort;
+        bool mHasSearchIndex;   ///< only accessed by #run()
+
+        // Constants
+        static const int sMaxPendingRows = 1000;
 };
 
 /*****************************************************************************************
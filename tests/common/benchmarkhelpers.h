@@ -0,0 +1,78 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKHELPERS_H
+#define BENCHMARKHELPERS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <iostream>
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class BenchmarkHelpers
+ ****************************************************************************************/
+
+/**
+ * @brief Helpers for the (disabled by default) benchmark tests, see README.md
+ */
+class BenchmarkHelpers final
+{
+    public:
+        BenchmarkHelpers() = delete;
+
+        /**
+         * @brief Call a function and measure how long it takes
+         *
+         * @return Duration in milliseconds (at least 1 to allow calculating rates)
+         */
+        template <typename Function>
+        static qint64 measure(Function function) {
+            QElapsedTimer timer;
+            timer.start();
+            function();
+            return qMax(timer.elapsed(), qint64(1));
+        }
+
+        /**
+         * @brief Print the result of a benchmark
+         *
+         * The debug output is disabled in main.cpp (only the output of gtest is wanted),
+         * so the result is printed directly to stdout.
+         */
+        static void report(const QString& result) {
+            std::cout << "[ BENCHMARK] " << qPrintable(result) << std::endl;
+        }
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
+
+#endif // BENCHMARKHELPERS_H
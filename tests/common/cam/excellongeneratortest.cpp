@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <algorithm>
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/excellongenerator.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ExcellonGeneratorTest : public ::testing::Test
+{
+    protected:
+        static QStringList getHits(const ExcellonGenerator& gen) {
+            QStringList hits;
+            foreach (const QString& line, gen.toStr().split('\n')) {
+                if (line.startsWith('X')) hits.append(line);
+            }
+            return hits;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ExcellonGeneratorTest, testTravelDistanceWithoutOptimization)
+{
+    ExcellonGenerator gen;
+    gen.drill(Point(3000000, 4000000), Length(1000000));
+    gen.generate();
+    EXPECT_EQ(Length(5000000), gen.getTravelDistance());
+}
+
+TEST_F(ExcellonGeneratorTest, testRouteOptimizationOnLine)
+{
+    // holes on a line in random order --> optimal route goes straight to the end
+    QList<int> positions;
+    for (int i = 1; i <= 50; ++i) positions.append(i);
+    std::random_shuffle(positions.begin(), positions.end());
+    ExcellonGenerator gen;
+    foreach (int x, positions) {
+        gen.drill(Point(x * 1000000, 0), Length(1000000));
+    }
+
+    gen.generate();
+    Length unoptimized = gen.getTravelDistance();
+
+    gen.setRouteOptimization(true);
+    gen.generate();
+    EXPECT_EQ(Length(50000000), gen.getTravelDistance());
+    EXPECT_LT(gen.getTravelDistance(), unoptimized);
+    EXPECT_EQ(50, getHits(gen).count());
+    EXPECT_EQ(QString("X1.0Y0.0"), getHits(gen).first());
+}
+
+TEST_F(ExcellonGeneratorTest, testRouteOptimizationKeepsAllHits)
+{
+    ExcellonGenerator gen;
+    for (int i = 0; i < 500; ++i) {
+        Point pos((qrand() % 100000) * 1000, (qrand() % 100000) * 1000);
+        gen.drill(pos, Length((i % 3 + 1) * 300000));
+    }
+    gen.generate();
+    QStringList unoptimizedHits = getHits(gen);
+    Length unoptimized = gen.getTravelDistance();
+
+    gen.setRouteOptimization(true);
+    gen.generate();
+    QStringList optimizedHits = getHits(gen);
+    EXPECT_LT(gen.getTravelDistance(), unoptimized);
+    EXPECT_EQ(500, optimizedHits.count());
+    std::sort(unoptimizedHits.begin(), unoptimizedHits.end());
+    std::sort(optimizedHits.begin(), optimizedHits.end());
+    EXPECT_EQ(unoptimizedHits, optimizedHits);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
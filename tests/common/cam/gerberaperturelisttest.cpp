@@ -0,0 +1,107 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/cam/gerberaperturelist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberApertureListTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberApertureListTest, testSameApertureReturnsSameNumber)
+{
+    GerberApertureList list;
+    int circle = list.setCircle(Length(1000000), Length(0));
+    int rect = list.setRect(Length(1000000), Length(2000000), Angle::deg0(), Length(0));
+    int rotatedRect = list.setRect(Length(1000000), Length(2000000), Angle::deg45(), Length(0));
+    int polygon = list.setRegularPolygon(Length(1000000), 8, Angle::deg0(), Length(0));
+    EXPECT_EQ(10, circle);
+    EXPECT_EQ(11, rect);
+    EXPECT_EQ(12, rotatedRect);
+    EXPECT_EQ(13, polygon);
+    EXPECT_EQ(circle, list.setCircle(Length(1000000), Length(0)));
+    EXPECT_EQ(circle, list.setCircle(Length(1000000), Length(-1)));
+    EXPECT_EQ(rect, list.setRect(Length(1000000), Length(2000000), Angle::deg180(), Length(0)));
+    EXPECT_EQ(rect, list.setRect(Length(2000000), Length(1000000), Angle::deg90(), Length(0)));
+    EXPECT_EQ(rotatedRect, list.setRect(Length(1000000), Length(2000000), Angle::deg45(), Length(0)));
+    EXPECT_EQ(polygon, list.setRegularPolygon(Length(1000000), 8, Angle::deg0(), Length(0)));
+}
+
+TEST_F(GerberApertureListTest, testDifferentAperturesReturnDifferentNumbers)
+{
+    GerberApertureList list;
+    QSet<int> numbers;
+    numbers.insert(list.setCircle(Length(1000000), Length(0)));
+    numbers.insert(list.setCircle(Length(1000000), Length(500000)));
+    numbers.insert(list.setCircle(Length(2000000), Length(0)));
+    numbers.insert(list.setRect(Length(1000000), Length(2000000), Angle::deg0(), Length(0)));
+    numbers.insert(list.setRect(Length(2000000), Length(1000000), Angle::deg0(), Length(0)));
+    numbers.insert(list.setObround(Length(1000000), Length(2000000), Angle::deg0(), Length(0)));
+    numbers.insert(list.setRegularPolygon(Length(1000000), 6, Angle::deg0(), Length(0)));
+    numbers.insert(list.setRegularPolygon(Length(1000000), 8, Angle::deg0(), Length(0)));
+    EXPECT_EQ(8, numbers.count());
+}
+
+TEST_F(GerberApertureListTest, testGenerateString)
+{
+    GerberApertureList list;
+    list.setCircle(Length(1000000), Length(0));
+    list.setCircle(Length(1000000), Length(0));
+    list.setRect(Length(1000000), Length(2000000), Angle::deg45(), Length(0));
+    QString str = list.generateString();
+    EXPECT_EQ(1, str.count("%ADD10C,"));
+    EXPECT_EQ(1, str.count("%ADD11ROTATEDRECT,"));
+    EXPECT_EQ(0, str.count("%ADD12"));
+    EXPECT_EQ(1, str.count("%AMROTATEDRECT*"));
+}
+
+TEST_F(GerberApertureListTest, testReset)
+{
+    GerberApertureList list;
+    list.setCircle(Length(1000000), Length(0));
+    list.setCircle(Length(2000000), Length(0));
+    list.reset();
+    EXPECT_EQ(10, list.setCircle(Length(2000000), Length(0)));
+    EXPECT_EQ(11, list.setCircle(Length(1000000), Length(0)));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
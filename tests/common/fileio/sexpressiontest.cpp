@@ -0,0 +1,172 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SExpressionTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(SExpressionTest, testParseEmptyList)
+{
+    SExpression s = SExpression::parse(QByteArray("(test)"), FilePath());
+    EXPECT_TRUE(s.isList());
+    EXPECT_EQ("test", s.getName());
+    EXPECT_EQ(0, s.getChildren().count());
+}
+
+TEST(SExpressionTest, testParseNested)
+{
+    QByteArray content = "; comment\n"
+                         "(root 1234 \"foo bar\"\n"
+                         " (child -0.5 (grandchild true)) ; comment\n"
+                         ")\n";
+    SExpression s = SExpression::parse(content, FilePath());
+    EXPECT_EQ("root", s.getName());
+    ASSERT_EQ(3, s.getChildren().count());
+    EXPECT_TRUE(s.getChildByIndex(0).isString());
+    EXPECT_EQ("1234", s.getChildByIndex(0).getValue<QString>(true));
+    EXPECT_TRUE(s.getChildByIndex(1).isString());
+    EXPECT_EQ("foo bar", s.getChildByIndex(1).getValue<QString>(true));
+    EXPECT_EQ("-0.5", s.getValueByPath<QString>("child", true));
+    EXPECT_EQ(true, s.getValueByPath<bool>("child/grandchild", true));
+}
+
+TEST(SExpressionTest, testParseEscapedString)
+{
+    QByteArray content = "(test \"a\\\"b\\\\c\\nd\\te\" \"multi\nline\" \"\xC3\xA4\")";
+    SExpression s = SExpression::parse(content, FilePath());
+    ASSERT_EQ(3, s.getChildren().count());
+    EXPECT_EQ("a\"b\\c\nd\te", s.getChildByIndex(0).getValue<QString>(true));
+    EXPECT_EQ("multi\nline", s.getChildByIndex(1).getValue<QString>(true));
+    EXPECT_EQ(QString::fromUtf8("\xC3\xA4"), s.getChildByIndex(2).getValue<QString>(true));
+}
+
+TEST(SExpressionTest, testParseFromQString)
+{
+    SExpression s = SExpression::parse(QString("(test \"%1\")").arg(QChar(0x00E4)),
+                                       FilePath());
+    EXPECT_EQ(QString(QChar(0x00E4)), s.getChildByIndex(0).getValue<QString>(true));
+}
+
+TEST(SExpressionTest, testSerializeAndParseAgain)
+{
+    QString str = QString("\"quoted\"\nline \\ break");
+    SExpression root = SExpression::createList("root");
+    root.appendTokenChild("token", QString("foo_bar"), false);
+    root.appendStringChild("string", str, true);
+    root.appendList("list", true).appendTokenChild("value", 42, false);
+    SExpression parsed = SExpression::parse(root.toString(0), FilePath());
+    EXPECT_EQ("foo_bar", parsed.getValueByPath<QString>("token", true));
+    EXPECT_EQ(str, parsed.getValueByPath<QString>("string", true));
+    EXPECT_EQ(42, parsed.getValueByPath<int>("list/value", true));
+}
+
+TEST(SExpressionTest, testSerialize)
+{
+    SExpression root = SExpression::createList("root");
+    root.appendToken(QString("token"));
+    root.appendString(QString("a \"b\"\n"));
+    root.appendTokenChild("single", 1, true);
+    SExpression& child = root.appendList("child", true);
+    child.appendTokenChild("value", true, true);
+    child.appendLineBreak();
+    child.appendLineBreak();
+    child.appendTokenChild("value", false, true);
+    root.appendLineBreak();
+    root.appendLineBreak();
+    QByteArray expected = "(root token \"a \\\"b\\\"\\n\"\n"
+                          " (single 1)\n"
+                          " (child\n"
+                          "  (value true)\n"
+                          "\n"
+                          "  (value false)\n"
+                          " )\n"
+                          "\n"
+                          ")";
+    EXPECT_EQ(expected, root.toByteArray(0));
+    EXPECT_EQ(QString::fromUtf8(expected), root.toString(0));
+}
+
+TEST(SExpressionTest, testWriteToDevice)
+{
+    SExpression root = SExpression::createList("root");
+    for (int i = 0; i < 20000; ++i) {  // big enough to flush the buffer several times
+        root.appendList("item", true).appendString(QString::number(i));
+    }
+    QBuffer buffer;
+    ASSERT_TRUE(buffer.open(QIODevice::WriteOnly));
+    root.writeToDevice(buffer, 0);
+    EXPECT_EQ(root.toByteArray(0), buffer.data());
+}
+
+TEST(SExpressionTest, testSerializeInvalidNodes)
+{
+    SExpression invalidName = SExpression::createList("Invalid");
+    EXPECT_THROW(invalidName.toByteArray(0), LogicError);
+    SExpression invalidToken = SExpression::createList("root");
+    invalidToken.appendToken(QString("foo bar"));
+    EXPECT_THROW(invalidToken.toByteArray(0), LogicError);
+}
+
+TEST(SExpressionTest, testParseErrors)
+{
+    QList<QByteArray> invalid = {
+        "",                     // no root node
+        "  ; comment only\n",   // no root node
+        "token",                // root is not a list
+        "(root) (second)",      // two root nodes
+        "(root",                // missing closing parenthesis
+        "(root (child)",        // missing closing parenthesis
+        "()",                   // list without name
+        "(root \"string)",      // unterminated string
+        "(root \"\\x\")",       // invalid escape sequence
+        "(root))",              // too many closing parentheses
+    };
+    foreach (const QByteArray& content, invalid) {
+        EXPECT_THROW(SExpression::parse(content, FilePath()), FileParseError) << content;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/sexprsnapshotwriter.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SExprSnapshotWriterTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            // create temporary, empty directory
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("SExprSnapshotWriterTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            FileUtils::makePath(mTempDir);
+        }
+
+        virtual void TearDown() override
+        {
+            // remove temporary directory
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        FilePath mTempDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(SExprSnapshotWriterTest, testWriteAllFiles)
+{
+    SExpression root1 = SExpression::createList("root1");
+    root1.appendStringChild("name", QString("foo"), true);
+    SExpression root2 = SExpression::createList("root2");
+    FilePath fp1 = mTempDir.getPathTo("file1.lp~");
+    FilePath fp2 = mTempDir.getPathTo("subdir/file2.lp~");
+
+    QList<SmartSExprFile::Snapshot> snapshots;
+    snapshots.append(SmartSExprFile::Snapshot(fp1, root1));
+    snapshots.append(SmartSExprFile::Snapshot(fp2, root2));
+
+    // modifying the DOM tree after capturing it must not affect the snapshot
+    root1.appendStringChild("name", QString("bar"), true);
+
+    QList<int> progress;
+    int writtenFiles = -1;
+    QString error;
+    SExprSnapshotWriter writer(snapshots);
+    QObject::connect(&writer, &SExprSnapshotWriter::progressUpdate,
+                     [&](int percent){progress.append(percent);});
+    QObject::connect(&writer, &SExprSnapshotWriter::succeeded,
+                     [&](int fileCount){writtenFiles = fileCount;});
+    QObject::connect(&writer, &SExprSnapshotWriter::failed,
+                     [&](const QString& msg){error = msg;});
+    writer.start();
+    EXPECT_TRUE(writer.wait(10000));
+
+    EXPECT_EQ(2, writtenFiles);
+    EXPECT_EQ(QString(), error);
+    EXPECT_EQ(QList<int>({50, 100}), progress);
+    EXPECT_EQ(QByteArray("(root1\n (name \"foo\")\n)\n"), FileUtils::readFile(fp1));
+    EXPECT_EQ(QByteArray("(root2)\n"), FileUtils::readFile(fp2));
+}
+
+TEST_F(SExprSnapshotWriterTest, testContinueAfterError)
+{
+    // a file in place of the parent directory makes writing the first snapshot fail
+    FileUtils::writeFile(mTempDir.getPathTo("blocker"), QByteArray("blocker"));
+    FilePath fp1 = mTempDir.getPathTo("blocker/file1.lp~");
+    FilePath fp2 = mTempDir.getPathTo("file2.lp~");
+
+    QList<SmartSExprFile::Snapshot> snapshots;
+    snapshots.append(SmartSExprFile::Snapshot(fp1, SExpression::createList("root1")));
+    snapshots.append(SmartSExprFile::Snapshot(fp2, SExpression::createList("root2")));
+
+    bool succeeded = false;
+    QString error;
+    SExprSnapshotWriter writer(snapshots);
+    QObject::connect(&writer, &SExprSnapshotWriter::succeeded,
+                     [&](){succeeded = true;});
+    QObject::connect(&writer, &SExprSnapshotWriter::failed,
+                     [&](const QString& msg){error = msg;});
+    writer.start();
+    EXPECT_TRUE(writer.wait(10000));
+
+    EXPECT_FALSE(succeeded);
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_FALSE(fp1.isExistingFile());
+    EXPECT_TRUE(fp2.isExistingFile());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
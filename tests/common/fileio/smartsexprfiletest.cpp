@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/fileio/smartsexprfile.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SmartSExprFileTest : public ::testing::Test
+{
+    protected:
+
+        virtual void SetUp() override
+        {
+            // create temporary, empty directory
+            mTempDir = FilePath::getApplicationTempPath().getPathTo("SmartSExprFileTest");
+            if (mTempDir.isExistingDir()) {
+                FileUtils::removeDirRecursively(mTempDir); // can throw
+            }
+            FileUtils::makePath(mTempDir);
+        }
+
+        virtual void TearDown() override
+        {
+            // remove temporary directory
+            FileUtils::removeDirRecursively(mTempDir); // can throw
+        }
+
+        FilePath mTempDir;
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(SmartSExprFileTest, testSaveWritesModifiedContent)
+{
+    FilePath fp = mTempDir.getPathTo("file.lp");
+    QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(fp));
+    file->save(SExpression::createList("root"), true);
+    EXPECT_EQ(QByteArray("(root)\n"), FileUtils::readFile(fp));
+
+    file->save(SExpression::createList("modified"), true);
+    EXPECT_EQ(QByteArray("(modified)\n"), FileUtils::readFile(fp));
+}
+
+TEST_F(SmartSExprFileTest, testSaveStreamsFormattedDomTree)
+{
+    SExpression root = SExpression::createList("root");
+    root.appendChild(SExpression::createString("foo \"bar\""), true);
+    root.appendList("child", true).appendChild(SExpression::createToken("42"), false);
+
+    // the streamed content must be equal to the formatted DOM tree, even if the
+    // parent directory does not exist yet
+    FilePath fp = mTempDir.getPathTo("subdir/file.lp");
+    QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(fp));
+    file->save(root, true);
+    EXPECT_EQ(root.toByteArray(0) + '\n', FileUtils::readFile(fp));
+}
+
+TEST_F(SmartSExprFileTest, testSaveOverwritesExternalModifications)
+{
+    FilePath fp = mTempDir.getPathTo("file.lp");
+    QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(fp));
+    file->save(SExpression::createList("root"), true);
+
+    // the saved content must not be trusted anymore if the file was modified externally
+    FileUtils::writeFile(fp, QByteArray("external"));
+    file->save(SExpression::createList("root"), true);
+    EXPECT_EQ(QByteArray("(root)\n"), FileUtils::readFile(fp));
+}
+
+TEST_F(SmartSExprFileTest, testSaveOverwritesExternalModificationsOfLoadedFile)
+{
+    FilePath fp = mTempDir.getPathTo("file.lp");
+    FileUtils::writeFile(fp, QByteArray("(root)\n"));
+    SmartSExprFile file(fp, false, false);
+    SExpression root = file.parseFileAndBuildDomTree();
+
+    // the loaded content must not be trusted anymore if the file was modified externally
+    FileUtils::writeFile(fp, QByteArray("external"));
+    file.save(root, true);
+    EXPECT_EQ(QByteArray("(root)\n"), FileUtils::readFile(fp));
+}
+
+TEST_F(SmartSExprFileTest, testSnapshotSkipsUnchangedContent)
+{
+    FilePath fp = mTempDir.getPathTo("file.lp~");
+    SExpression root = SExpression::createList("root");
+
+    // the content of existing files is compared if its hash is not known
+    EXPECT_TRUE(SmartSExprFile::Snapshot(fp, root).write());
+    EXPECT_FALSE(SmartSExprFile::Snapshot(fp, root).write());
+    EXPECT_TRUE(SmartSExprFile::Snapshot(fp, SExpression::createList("foo")).write());
+    EXPECT_EQ(QByteArray("(foo)\n"), FileUtils::readFile(fp));
+
+    // a removed file must be written again
+    FileUtils::removeFile(fp);
+    EXPECT_TRUE(SmartSExprFile::Snapshot(fp, root).write());
+    EXPECT_EQ(QByteArray("(root)\n"), FileUtils::readFile(fp));
+}
+
+TEST_F(SmartSExprFileTest, testSnapshotHandsBackStateOfBackupFile)
+{
+    FilePath fp = mTempDir.getPathTo("file.lp");
+    FilePath backupFp = mTempDir.getPathTo("file.lp~");
+    QScopedPointer<SmartSExprFile> file(SmartSExprFile::create(fp));
+
+    // the state of the written backup file is taken over by the next snapshot/save
+    EXPECT_TRUE(file->createSnapshot(SExpression::createList("root")).write());
+    EXPECT_FALSE(file->createSnapshot(SExpression::createList("root")).write());
+    EXPECT_TRUE(file->createSnapshot(SExpression::createList("foo")).write());
+    EXPECT_EQ(QByteArray("(foo)\n"), FileUtils::readFile(backupFp));
+    file->save(SExpression::createList("root"), false);
+    EXPECT_EQ(QByteArray("(root)\n"), FileUtils::readFile(backupFp));
+
+    // external modifications of the backup file must still be detected
+    FileUtils::writeFile(backupFp, QByteArray("external"));
+    EXPECT_TRUE(file->createSnapshot(SExpression::createList("root")).write());
+    EXPECT_EQ(QByteArray("(root)\n"), FileUtils::readFile(backupFp));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -25,7 +25,9 @@
 #include <QtConcurrent>
 #include <gtest/gtest.h>
 #include <librepcb/common/sqlitedatabase.h>
+#include <librepcb/common/uuid.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include "benchmarkhelpers.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -163,6 +165,128 @@ TEST_F(SQLiteDatabaseTest, testInsert)
     }
 }
 
+TEST_F(SQLiteDatabaseTest, testPrepareCachedQuery)
+{
+    SQLiteDatabase db(mTempDbFilePath);
+    db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT)");
+    for (int i = 0; i < 100; ++i) {
+        QSqlQuery query = db.prepareCachedQuery("INSERT INTO test (name) VALUES (:name)");
+        query.bindValue(":name", QString("row %1").arg(i));
+        int id = db.insert(query);
+        EXPECT_EQ(i + 1, id);
+    }
+}
+
+TEST_F(SQLiteDatabaseTest, testInsertMultiple)
+{
+    SQLiteDatabase db(mTempDbFilePath);
+    db.exec("CREATE TABLE test (`id` INTEGER PRIMARY KEY NOT NULL, `name` TEXT, `value` INTEGER)");
+    QList<QVariantList> rows;
+    for (int i = 0; i < 1234; ++i) { // more rows than fit into a single statement
+        rows.append(QVariantList{QString("row %1").arg(i), i});
+    }
+    db.insertMultiple("test", {"name", "value"}, rows);
+
+    // insert again with another number of rows in the last statement
+    QList<QVariantList> moreRows;
+    for (int i = 0; i < 10; ++i) {
+        moreRows.append(QVariantList{QString("more row %1").arg(i), i});
+    }
+    db.insertMultiple("test", {"name", "value"}, moreRows);
+    rows.append(moreRows);
+
+    QSqlQuery query = db.prepareQuery("SELECT name, value FROM test ORDER BY id");
+    db.exec(query);
+    int count = 0;
+    while (query.next()) {
+        EXPECT_EQ(rows.at(count).at(0).toString(), query.value(0).toString());
+        EXPECT_EQ(rows.at(count).at(1).toInt(), query.value(1).toInt());
+        ++count;
+    }
+    EXPECT_EQ(rows.count(), count);
+}
+
+/**
+ * Benchmark which compares inserting a synthetic library with 50k elements (each with
+ * two translations) row by row with newly prepared statements against using cached
+ * statements and multi-row inserts. It only reports the inserted rows per second, so it
+ * is disabled by default. Run it with "--gtest_also_run_disabled_tests".
+ */
+TEST_F(SQLiteDatabaseTest, DISABLED_benchmarkInsertPerformance)
+{
+    const int elementCount = 50000;
+    const QString elementSql = "INSERT INTO elements (filepath, uuid, version) "
+                               "VALUES (:filepath, :uuid, :version)";
+    const QString translationSql = "INSERT INTO elements_tr (element_id, locale, name) "
+                                   "VALUES (:element_id, :locale, :name)";
+    auto createTables = [](SQLiteDatabase& db) {
+        db.exec("CREATE TABLE elements (`id` INTEGER PRIMARY KEY NOT NULL, "
+                "`filepath` TEXT UNIQUE NOT NULL, `uuid` TEXT NOT NULL, `version` TEXT NOT NULL)");
+        db.exec("CREATE TABLE elements_tr (`id` INTEGER PRIMARY KEY NOT NULL, "
+                "`element_id` INTEGER REFERENCES elements(id) NOT NULL, "
+                "`locale` TEXT NOT NULL, `name` TEXT, UNIQUE(element_id, locale))");
+    };
+    auto insertElement = [](SQLiteDatabase& db, QSqlQuery& query, int i) {
+        query.bindValue(":filepath", QString("lib/sym/%1").arg(i));
+        query.bindValue(":uuid", Uuid::createRandom().toStr());
+        query.bindValue(":version", "0.1");
+        return db.insert(query);
+    };
+
+    // before: every row is inserted with a newly prepared statement
+    qint64 uncachedDuration = 0;
+    {
+        SQLiteDatabase db(mTempDir.getPathTo("uncached.sqlite"));
+        createTables(db);
+        SQLiteDatabase::TransactionScopeGuard tsg(db);
+        uncachedDuration = BenchmarkHelpers::measure([&]() {
+            for (int i = 0; i < elementCount; ++i) {
+                QSqlQuery query = db.prepareQuery(elementSql);
+                int id = insertElement(db, query, i);
+                foreach (const QString& locale, QStringList{"en_US", "de_DE"}) {
+                    QSqlQuery query = db.prepareQuery(translationSql);
+                    query.bindValue(":element_id", id);
+                    query.bindValue(":locale", locale);
+                    query.bindValue(":name", QString("Element %1").arg(i));
+                    db.insert(query);
+                }
+            }
+        });
+        tsg.commit();
+    }
+
+    // after: cached statements for elements, multi-row inserts for translations
+    qint64 cachedDuration = 0;
+    {
+        SQLiteDatabase db(mTempDir.getPathTo("cached.sqlite"));
+        createTables(db);
+        SQLiteDatabase::TransactionScopeGuard tsg(db);
+        cachedDuration = BenchmarkHelpers::measure([&]() {
+            QList<QVariantList> translations;
+            for (int i = 0; i < elementCount; ++i) {
+                QSqlQuery query = db.prepareCachedQuery(elementSql);
+                int id = insertElement(db, query, i);
+                foreach (const QString& locale, QStringList{"en_US", "de_DE"}) {
+                    translations.append(QVariantList{id, locale, QString("Element %1").arg(i)});
+                }
+                if (translations.count() >= 1000) {
+                    db.insertMultiple("elements_tr", {"element_id", "locale", "name"},
+                                      translations);
+                    translations.clear();
+                }
+            }
+            db.insertMultiple("elements_tr", {"element_id", "locale", "name"}, translations);
+        });
+        tsg.commit();
+    }
+
+    qint64 rowCount = elementCount * 3;
+    BenchmarkHelpers::report(QString("Inserted %1 rows: %2 rows/s without statement cache, "
+                                     "%3 rows/s with statement cache and batches")
+                             .arg(rowCount).arg((rowCount * 1000) / uncachedDuration)
+                             .arg((rowCount * 1000) / cachedDuration));
+}
+
 TEST_F(SQLiteDatabaseTest, testClearExistingTable)
 {
     SQLiteDatabase db(mTempDbFilePath);
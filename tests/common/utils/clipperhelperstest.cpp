@@ -0,0 +1,86 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <clipper/clipper.hpp>
+#include <librepcb/common/utils/clipperhelpers.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ClipperHelpersTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(ClipperHelpersTest, testGetBoundingRect)
+{
+    ClipperLib::Paths paths;
+    ClipperLib::IntRect empty = ClipperHelpers::getBoundingRect(paths);
+    EXPECT_EQ(0, empty.left);
+    EXPECT_EQ(0, empty.top);
+    EXPECT_EQ(0, empty.right);
+    EXPECT_EQ(0, empty.bottom);
+
+    paths.push_back({ClipperLib::IntPoint(10, -5), ClipperLib::IntPoint(20, 30)});
+    paths.push_back({ClipperLib::IntPoint(-15, 0), ClipperLib::IntPoint(5, 7)});
+    ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(paths);
+    EXPECT_EQ(-15, rect.left);
+    EXPECT_EQ(-5, rect.top);
+    EXPECT_EQ(20, rect.right);
+    EXPECT_EQ(30, rect.bottom);
+}
+
+TEST_F(ClipperHelpersTest, testIntersects)
+{
+    ClipperLib::IntRect a = {0, 0, 10, 10};
+    ClipperLib::IntRect inside = {2, 2, 8, 8};
+    ClipperLib::IntRect overlapping = {5, -5, 15, 5};
+    ClipperLib::IntRect touching = {10, 10, 20, 20};
+    ClipperLib::IntRect left = {-20, 0, -1, 10};
+    ClipperLib::IntRect below = {0, 11, 10, 20};
+    EXPECT_TRUE(ClipperHelpers::intersects(a, a));
+    EXPECT_TRUE(ClipperHelpers::intersects(a, inside));
+    EXPECT_TRUE(ClipperHelpers::intersects(inside, a));
+    EXPECT_TRUE(ClipperHelpers::intersects(a, overlapping));
+    EXPECT_TRUE(ClipperHelpers::intersects(a, touching));
+    EXPECT_FALSE(ClipperHelpers::intersects(a, left));
+    EXPECT_FALSE(ClipperHelpers::intersects(below, a));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
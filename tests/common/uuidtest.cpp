@@ -24,6 +24,8 @@
 #include <QtCore>
 #include <gtest/gtest.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include "benchmarkhelpers.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -40,6 +42,62 @@ typedef struct {
     QString uuid;
 } UuidTestData;
 
+/**
+ * The former implementation of #Uuid (validated with QUuid and stored as a lowercase
+ * string), used to compare the performance against the current implementation
+ */
+struct StringUuid {
+    QString mUuid;
+    explicit StringUuid(const QString& uuid) noexcept {
+        QString lowercaseUuid = uuid.toLower();
+        if (lowercaseUuid.length() != 36) return;
+        QUuid quuid(lowercaseUuid);
+        if (quuid.isNull() || (quuid.variant() != QUuid::DCE) ||
+            (quuid.version() != QUuid::Random)) return;
+        mUuid = lowercaseUuid;
+    }
+    bool operator==(const StringUuid& rhs) const noexcept {
+        return (!mUuid.isEmpty()) && (mUuid == rhs.mUuid);
+    }
+    bool operator<(const StringUuid& rhs) const noexcept {
+        return (!mUuid.isEmpty()) && (!rhs.mUuid.isEmpty()) && (mUuid < rhs.mUuid);
+    }
+};
+
+inline uint qHash(const StringUuid& key, uint seed) noexcept
+{
+    return ::qHash(key.mUuid, seed);
+}
+
+/**
+ * Load elements into UUID keyed maps (like the board does) and resolve the references
+ * of the lines to the net points, for #DISABLED_benchmarkLoadLargeProject
+ *
+ * @return Duration in milliseconds
+ */
+template <typename UuidType>
+static qint64 loadElements(const QList<SExpression>& netpointNodes,
+                           const QList<SExpression>& lineNodes)
+{
+    QHash<UuidType, int> netpoints;
+    QMap<UuidType, int> lines;
+    int resolved = 0;
+    qint64 duration = BenchmarkHelpers::measure([&]() {
+        for (int i = 0; i < netpointNodes.count(); i++) {
+            const SExpression& node = netpointNodes.at(i);
+            netpoints.insert(UuidType(node.getValueOfFirstChild<QString>(true)), i);
+        }
+        for (int i = 0; i < lineNodes.count(); i++) {
+            const SExpression& node = lineNodes.at(i);
+            lines.insert(UuidType(node.getValueOfFirstChild<QString>(true)), i);
+            resolved += netpoints.contains(UuidType(node.getValueByPath<QString>("from", true)));
+            resolved += netpoints.contains(UuidType(node.getValueByPath<QString>("to", true)));
+        }
+    });
+    EXPECT_EQ(2 * lineNodes.count(), resolved);
+    return duration;
+}
+
 /*****************************************************************************************
  *  Test Class
  ****************************************************************************************/
@@ -217,6 +275,45 @@ TEST(UuidTest, testCreateRandom)
     }
 }
 
+TEST(UuidTest, testOrderingMatchesStrings)
+{
+    QList<Uuid> uuids;
+    QStringList strings;
+    for (int i = 0; i < 1000; i++) {
+        Uuid uuid = Uuid::createRandom();
+        uuids.append(uuid);
+        strings.append(uuid.toStr());
+    }
+    std::sort(uuids.begin(), uuids.end());
+    std::sort(strings.begin(), strings.end());
+    for (int i = 0; i < uuids.count(); i++) {
+        EXPECT_EQ(strings.at(i), uuids.at(i).toStr());
+    }
+}
+
+TEST(UuidTest, testHashAndMapLookup)
+{
+    QHash<Uuid, int> hash;
+    QMap<Uuid, int> map;
+    QStringList strings;
+    for (int i = 0; i < 1000; i++) {
+        Uuid uuid = Uuid::createRandom();
+        hash.insert(uuid, i);
+        map.insert(uuid, i);
+        strings.append(uuid.toStr());
+    }
+    EXPECT_EQ(1000, hash.count());
+    EXPECT_EQ(1000, map.count());
+    for (int i = 0; i < strings.count(); i++) {
+        Uuid uuid(strings.at(i)); // equal UUIDs must have equal hashes
+        EXPECT_EQ(i, hash.value(uuid, -1));
+        EXPECT_EQ(i, map.value(uuid, -1));
+    }
+    EXPECT_FALSE(hash.contains(Uuid::createRandom()));
+    EXPECT_FALSE(map.contains(Uuid::createRandom()));
+    EXPECT_EQ(16U, sizeof(Uuid)); // stored as two 64 bit integers instead of a string
+}
+
 /*****************************************************************************************
  *  Test Data
  ****************************************************************************************/
@@ -269,6 +366,56 @@ INSTANTIATE_TEST_CASE_P(UuidTest, UuidTest, ::testing::Values(
     UuidTestData({false, "bdf7bea5 b88e 41b2 be85 c1604e8ddfca"  })     // spaces
 ));
 
+/**
+ * Benchmark which loads a generated board with 100k net points and 100k net lines
+ * (each referencing two net points by their UUID) into UUID keyed maps, once with the
+ * former string based UUID and once with #Uuid. It only reports timings and memory
+ * usage, so it is disabled by default. Run it with "--gtest_also_run_disabled_tests".
+ */
+TEST(UuidTest, DISABLED_benchmarkLoadLargeProject)
+{
+    const int count = 100000;
+    QStringList netpoints;
+    for (int i = 0; i < count; i++) {
+        netpoints.append(Uuid::createRandom().toStr());
+    }
+    SExpression generatedRoot = SExpression::createList("librepcb_board");
+    for (int i = 0; i < count; i++) {
+        generatedRoot.appendList("netpoint", true).appendToken(netpoints.at(i));
+    }
+    for (int i = 0; i < count; i++) {
+        SExpression& line = generatedRoot.appendList("line", true);
+        line.appendToken(Uuid::createRandom().toStr());
+        line.appendTokenChild("from", netpoints.at(i), false);
+        line.appendTokenChild("to", netpoints.at((i + 1) % count), false);
+    }
+    QString content = generatedRoot.toString(0);
+
+    // parsing the file is the same for both implementations, so it is done only once
+    QList<SExpression> netpointNodes;
+    QList<SExpression> lineNodes;
+    qint64 parseDuration = BenchmarkHelpers::measure([&]() {
+        SExpression root = SExpression::parse(content, FilePath());
+        netpointNodes = root.getChildren("netpoint");
+        lineNodes = root.getChildren("line");
+    });
+
+    qint64 stringDuration = loadElements<StringUuid>(netpointNodes, lineNodes);
+    qint64 uuidDuration = loadElements<Uuid>(netpointNodes, lineNodes);
+
+    // a QString with 36 characters needs a heap allocated block (header + UTF-16 data)
+    // in addition to the object stored in the map node
+    int stringMemory = sizeof(StringUuid) + sizeof(QArrayData) + 37 * sizeof(QChar);
+    int uuidMemory = sizeof(Uuid);
+
+    BenchmarkHelpers::report(QString("Loaded %1 elements (parsed in %2 ms): %3 ms with "
+                                     "string UUIDs, %4 ms with integer UUIDs; %5 vs. %6 "
+                                     "bytes per UUID key (%7 KiB less for all keys)")
+                             .arg(2 * count).arg(parseDuration).arg(stringDuration)
+                             .arg(uuidDuration).arg(stringMemory).arg(uuidMemory)
+                             .arg(((stringMemory - uuidMemory) * 2 * count) / 1024));
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardclearanceareacache.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_netpoint.h>
+#include <librepcb/project/boards/items/bi_netline.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include "../../common/benchmarkhelpers.h"
+#include "../projectfixture.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+using librepcb::tests::BenchmarkHelpers;
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class BoardPlaneFragmentsBuilderTest : public ProjectFixture
+{
+    protected:
+        Board* mBoard;
+        NetSignal* mPlaneNetSignal;
+        NetSignal* mTracesNetSignal;
+
+        BoardPlaneFragmentsBuilderTest() {
+            mBoard = mProject->createBoard("board");
+            mProject->addBoard(*mBoard);
+            mPlaneNetSignal = addNetSignal("plane");
+            mTracesNetSignal = addNetSignal("traces");
+        }
+
+        /**
+         * Fill an area of 100x100mm on the top layer with horizontal traces (0.2mm wide,
+         * 5mm long) with the specified pitch, like on a dense board
+         */
+        void addTraces(const Length& pitch) {
+            GraphicsLayer* layer = mBoard->getLayerStack().getLayer(GraphicsLayer::sTopCopper);
+            for (Length y(0); y <= Length::fromMm(100); y += pitch) {
+                BI_NetSegment* netsegment = new BI_NetSegment(*mBoard, *mTracesNetSignal);
+                mBoard->addNetSegment(*netsegment);
+                QList<BI_NetPoint*> netpoints;
+                QList<BI_NetLine*> netlines;
+                for (int x = 0; x <= 20; ++x) {
+                    netpoints.append(new BI_NetPoint(*netsegment, *layer,
+                                                     Point(Length::fromMm(x * 5), y)));
+                    if (x > 0) {
+                        netlines.append(new BI_NetLine(*netpoints.at(x - 1),
+                                                       *netpoints.at(x), Length::fromMm(0.2)));
+                    }
+                }
+                netsegment->addElements({}, netpoints, netlines);
+            }
+        }
+
+        /**
+         * Build the fragments of a 10x10mm plane in the middle of the board
+         *
+         * @return The fragments and the duration in milliseconds
+         */
+        QPair<QVector<Path>, qint64> buildSmallPlane(bool prefilter) {
+            BI_Plane plane(*mBoard, Uuid::createRandom(), GraphicsLayer::sTopCopper,
+                           *mPlaneNetSignal, Path::rect(Point::fromMm(45, 45),
+                                                        Point::fromMm(55, 55)));
+            BoardClearanceAreaCache areaCache(BoardPlaneFragmentsBuilder::maxArcTolerance());
+            BoardPlaneFragmentsBuilder builder(plane, areaCache);
+            builder.setBoundingRectPrefilterEnabled(prefilter);
+            QVector<Path> fragments;
+            qint64 duration = BenchmarkHelpers::measure([&]() {
+                fragments = builder.buildFragments();
+            });
+            return qMakePair(fragments, duration);
+        }
+
+        static double getArea(const QVector<Path>& fragments) {
+            double area = 0;
+            for (const ClipperLib::Path& path : ClipperHelpers::convert(fragments,
+                 BoardPlaneFragmentsBuilder::maxArcTolerance())) {
+                area += ClipperLib::Area(path);
+            }
+            return area;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testBoundingRectPrefilterKeepsResult)
+{
+    addTraces(Length::fromMm(2));
+    QVector<Path> filtered = buildSmallPlane(true).first;
+    QVector<Path> unfiltered = buildSmallPlane(false).first;
+    EXPECT_FALSE(filtered.isEmpty());
+    EXPECT_EQ(unfiltered.count(), filtered.count());
+    EXPECT_NEAR(getArea(unfiltered), getArea(filtered), 1000.0); // nm², summation order
+}
+
+/**
+ * Benchmark which builds a small plane on a dense board, with and without the bounding
+ * rect prefilter. It only reports timings, so it is disabled by default. Run it with
+ * "--gtest_also_run_disabled_tests".
+ */
+TEST_F(BoardPlaneFragmentsBuilderTest, DISABLED_benchmarkSmallPlaneOnDenseBoard)
+{
+    addTraces(Length::fromMm(0.4));
+    QPair<QVector<Path>, qint64> unfiltered = buildSmallPlane(false);
+    QPair<QVector<Path>, qint64> filtered = buildSmallPlane(true);
+    EXPECT_EQ(unfiltered.first.count(), filtered.first.count());
+    EXPECT_NEAR(getArea(unfiltered.first), getArea(filtered.first), 1000.0);
+
+    BenchmarkHelpers::report(QString("Built %1 plane fragments: %2 ms without prefilter, "
+                                     "%3 ms with prefilter").arg(filtered.first.count())
+                             .arg(unfiltered.second).arg(filtered.second));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
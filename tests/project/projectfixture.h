@@ -0,0 +1,85 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROJECTFIXTURE_H
+#define PROJECTFIXTURE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netclass.h>
+#include <librepcb/project/circuit/netsignal.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Class ProjectFixture
+ ****************************************************************************************/
+
+/**
+ * @brief Base class for tests which need a (temporary) project with a net class
+ *
+ * The project directory is removed again when the test is finished.
+ */
+class ProjectFixture : public ::testing::Test
+{
+    protected:
+        FilePath mProjectDir;
+        QScopedPointer<Project> mProject;
+        NetClass* mNetClass;
+
+        ProjectFixture() {
+            mProjectDir = FilePath::getRandomTempPath();
+            mProject.reset(Project::create(mProjectDir.getPathTo("project.lpp")));
+            Circuit& circuit = mProject->getCircuit();
+            mNetClass = new NetClass(circuit, "netclass");
+            circuit.addNetClass(*mNetClass);
+        }
+
+        virtual ~ProjectFixture() {
+            mProject.reset();
+            QDir(mProjectDir.toStr()).removeRecursively();
+        }
+
+        NetSignal* addNetSignal(const QString& name) {
+            Circuit& circuit = mProject->getCircuit();
+            NetSignal* netsignal = new NetSignal(circuit, *mNetClass, name, false);
+            circuit.addNetSignal(*netsignal);
+            return netsignal;
+        }
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
+
+#endif // PROJECTFIXTURE_H
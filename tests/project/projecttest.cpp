@@ -147,6 +147,29 @@ TEST_F(ProjectTest, testIfLastModifiedDateTimeIsUpdatedOnSave)
     EXPECT_NE(datetimeAfterCreating, datetimeAfterSaving);
 }
 
+TEST_F(ProjectTest, testIfMetadataIsNotRewrittenOnSavingUnmodifiedProject)
+{
+    // create and save new project, then close and re-open it
+    QScopedPointer<Project> project(Project::create(mProjectFile));
+    project->save(false);
+    project->save(true);
+    project.reset(new Project(mProjectFile, false));
+    FilePath metadataFile = mProjectDir.getPathTo("core/metadata.lp");
+    QDateTime datetimeAfterOpening = project->getMetadata().getLastModified();
+    QDateTime fileModifiedAfterOpening = QFileInfo(metadataFile.toStr()).lastModified();
+
+    // save the unmodified project twice (like the project editor does)
+    for (int i = 0; i < 2; ++i) {
+        QThread::msleep(1000); // the file system might have a resolution of 1s
+        project->save(false);
+        project->save(true);
+    }
+
+    // neither the attribute nor the file must have been changed
+    EXPECT_EQ(datetimeAfterOpening, project->getMetadata().getLastModified());
+    EXPECT_EQ(fileModifiedAfterOpening, QFileInfo(metadataFile.toStr()).lastModified());
+}
+
 TEST_F(ProjectTest, testSettersGetters)
 {
     // create new project
@@ -0,0 +1,99 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <librepcb/project/schematics/items/si_netsegment.h>
+#include <librepcb/project/schematics/items/si_netpoint.h>
+#include <librepcb/project/schematics/items/si_netline.h>
+#include "../projectfixture.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SchematicTest : public ProjectFixture
+{
+    protected:
+        Schematic* mSchematic;
+        SI_NetSegment* mNetSegment;
+        SI_NetLine* mNetLine;
+
+        SchematicTest() {
+            mSchematic = mProject->createSchematic("schematic");
+            mProject->addSchematic(*mSchematic);
+
+            // horizontal net line from (0, 0) to (10mm, 0) with the default wire width
+            mNetSegment = new SI_NetSegment(*mSchematic, *addNetSignal("netsignal"));
+            mSchematic->addNetSegment(*mNetSegment);
+            SI_NetPoint* p1 = new SI_NetPoint(*mNetSegment, Point(0, 0));
+            SI_NetPoint* p2 = new SI_NetPoint(*mNetSegment, Point(10000000, 0));
+            mNetLine = new SI_NetLine(*p1, *p2, Length(158750));
+            mNetSegment->addNetPointsAndNetLines({p1, p2}, {mNetLine});
+        }
+
+        virtual ~SchematicTest() {
+            mSchematic->removeNetSegment(*mNetSegment);
+            delete mNetSegment;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(SchematicTest, testGetNetLinesAtScenePosWithinGrabArea)
+{
+    // the grab area of net lines is much wider than the line itself
+    QList<SI_NetLine*> expected = {mNetLine};
+    EXPECT_EQ(expected, mSchematic->getNetLinesAtScenePos(Point(5000000, 0)));
+    EXPECT_EQ(expected, mSchematic->getNetLinesAtScenePos(Point(5000000, 500000)));
+    EXPECT_EQ(expected, mSchematic->getNetLinesAtScenePos(Point(5000000, -500000)));
+    EXPECT_EQ(expected, mSchematic->getNetLinesAtScenePos(Point(-500000, 0)));
+    EXPECT_TRUE(mSchematic->getNetLinesAtScenePos(Point(5000000, 1000000)).isEmpty());
+}
+
+TEST_F(SchematicTest, testSetSelectionRectWithinGrabArea)
+{
+    // a selection rect which only touches the grab area of the net line selects it
+    mSchematic->setSelectionRect(Point(4000000, 400000), Point(6000000, 600000), true);
+    EXPECT_TRUE(mNetLine->isSelected());
+
+    mSchematic->setSelectionRect(Point(4000000, 1000000), Point(6000000, 1200000), true);
+    EXPECT_FALSE(mNetLine->isSelected());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace project
+} // namespace librepcb
@@ -65,9 +65,14 @@ PRE_TARGETDEPS += \
 SOURCES += \
     common/applicationtest.cpp \
     common/attributes/attributesubstitutortest.cpp \
+    common/cam/excellongeneratortest.cpp \
+    common/cam/gerberaperturelisttest.cpp \
     common/directorylocktest.cpp \
     common/filedownloadtest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sexpressiontest.cpp \
+    common/fileio/sexprsnapshotwritertest.cpp \
+    common/fileio/smartsexprfiletest.cpp \
     common/filepathtest.cpp \
     common/networkrequesttest.cpp \
     common/pointtest.cpp \
@@ -76,6 +81,7 @@ SOURCES += \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/utils/clipperhelperstest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     eagleimport/deviceconvertertest.cpp \
@@ -83,13 +89,17 @@ SOURCES += \
     eagleimport/packageconvertertest.cpp \
     eagleimport/symbolconvertertest.cpp \
     main.cpp \
+    project/boards/boardplanefragmentsbuildertest.cpp \
     project/projecttest.cpp \
+    project/schematics/schematictest.cpp \
     workspace/workspacetest.cpp \
 
 HEADERS += \
     common/attributes/attributeproviderdummy.h \
+    common/benchmarkhelpers.h \
     common/fileio/serializableobjectmock.h \
     common/networkrequestbasesignalreceiver.h \
+    project/projectfixture.h \
 
 FORMS += \
 